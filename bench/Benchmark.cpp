@@ -0,0 +1,347 @@
+#include "Benchmark.h"
+#include "PerfCounters.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <cstdlib>
+#include <thread>
+
+#ifdef LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using BSignals::ExecutorScheme;
+
+namespace{
+
+//pinning is linux only, elsewhere threads are left where the os puts them
+void setAffinity(const std::vector<uint32_t>& cpus){
+#ifdef LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus) CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+bool matchesFilter(const std::string& name, const std::string& filter){
+    if (filter.empty()) return true;
+    std::stringstream ss(filter);
+    std::string term;
+    while (std::getline(ss, term, ',')){
+        if (!term.empty() && name.find(term) != std::string::npos) return true;
+    }
+    return false;
+}
+
+double interpolate(const std::vector<double>& sorted, double percentile){
+    double rank = percentile/100.0*(sorted.size() - 1);
+    size_t below = (size_t)rank;
+    if (below + 1 >= sorted.size()) return sorted.back();
+    return sorted[below] + (rank - below)*(sorted[below + 1] - sorted[below]);
+}
+
+const std::string timePerOperation = "ns/op";
+
+PerfCounters::Scope getCounterScope(const BenchmarkOptions& options){
+    if (!options.counters) return PerfCounters::Scope::NONE;
+    static const PerfCounters::Scope scope = PerfCounters(getAllowedCpus()).getScope();
+    return scope;
+}
+
+//counts per operation, and instructions per cycle
+void addCounterMetrics(BenchmarkSample& sample, const std::map<std::string, double>& counts){
+    double operations = (double)std::max<uint64_t>(sample.operations, 1);
+    for (auto const &kvpair : counts){
+        sample.metrics[kvpair.first + "_per_op"] = kvpair.second/operations;
+    }
+    auto cycles = counts.find("cycles");
+    auto instructions = counts.find("instructions");
+    if (cycles != counts.end() && instructions != counts.end() && cycles->second > 0){
+        sample.metrics["ipc"] = instructions->second/cycles->second;
+    }
+}
+
+void writeParameters(const std::vector<std::pair<std::string, std::string>>& parameters, std::ostream& out){
+    out << "{";
+    for (size_t i=0; i<parameters.size(); ++i){
+        out << (i ? "," : "") << "\"" << parameters[i].first << "\":\"" << parameters[i].second << "\"";
+    }
+    out << "}";
+}
+
+}
+
+const std::vector<uint32_t>& getAllowedCpus(){
+    static const std::vector<uint32_t> cpus = [](){
+        std::vector<uint32_t> allowed;
+#ifdef LINUX
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0){
+            for (uint32_t cpu=0; cpu<CPU_SETSIZE; ++cpu){
+                if (CPU_ISSET(cpu, &set)) allowed.push_back(cpu);
+            }
+        }
+#else
+        for (uint32_t cpu=0; cpu<std::thread::hardware_concurrency(); ++cpu) allowed.push_back(cpu);
+#endif
+        if (allowed.empty()) allowed.push_back(0);
+        return allowed;
+    }();
+    return cpus;
+}
+
+void BenchmarkContext::pinThread(uint32_t index) const {
+    if (!options.pin) return;
+    const auto &cpus = (options.cpus.empty() ? getAllowedCpus() : options.cpus);
+    setAffinity({cpus[index % cpus.size()]});
+}
+
+void BenchmarkContext::unpinThread() const {
+    if (options.pin) setAffinity(getAllowedCpus());
+}
+
+uint64_t BenchmarkContext::scaled(uint64_t operations) const {
+    return std::max<uint64_t>(1, (uint64_t)(operations*options.scale));
+}
+
+void BenchmarkContext::beginMeasurement() const {
+    if (counters) counters->start();
+}
+
+void BenchmarkContext::endMeasurement() const {
+    if (counters) counters->stop();
+}
+
+void BenchmarkRegistry::add(Benchmark benchmark) {
+    benchmarks.push_back(std::move(benchmark));
+}
+
+std::vector<std::string> BenchmarkRegistry::getNames(const std::string& filter) const {
+    std::vector<std::string> names;
+    for (auto const &benchmark : benchmarks){
+        if (matchesFilter(benchmark.name, filter)) names.push_back(benchmark.name);
+    }
+    return names;
+}
+
+std::vector<BenchmarkResult> BenchmarkRegistry::run(const BenchmarkOptions& options, std::ostream& log) const {
+    BenchmarkContext context(options);
+    std::vector<BenchmarkResult> results;
+    PerfCounters::Scope counterScope = getCounterScope(options);
+    if (options.counters){
+        log << "performance counters: " << PerfCounters::getScopeName(counterScope)
+            << " (" << PerfCounters::getScopeDescription(counterScope) << ")" << std::endl;
+    }
+    for (auto const &benchmark : benchmarks){
+        if (!matchesFilter(benchmark.name, options.filter)) continue;
+        bool skipped = false;
+        std::string skipReason;
+        context.warmup = true;
+        for (uint32_t i=0; i<options.warmup && !skipped; ++i){
+            BenchmarkSample sample = benchmark.run(context);
+            context.unpinThread();
+            skipped = sample.skipped;
+            skipReason = sample.skipReason;
+        }
+        context.warmup = false;
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.parameters = benchmark.parameters;
+        result.unit = benchmark.unit;
+        std::map<std::string, std::vector<double>> metrics;
+        const bool collectCounters = (counterScope != PerfCounters::Scope::NONE && benchmark.unit == timePerOperation);
+        result.countersComplete = !(collectCounters && counterScope == PerfCounters::Scope::THREAD && benchmark.usesPersistentThreads);
+        for (uint32_t i=0; i<std::max(options.repetitions, 1u) && !skipped; ++i){
+            //opened for each repetition, so that in thread scope they're
+            //inherited by the threads the benchmark creates. They count the
+            //whole repetition unless the benchmark brackets its measured
+            //region, and are read after it returns, once its threads have
+            //exited (and added their counts)
+            std::unique_ptr<PerfCounters> counters;
+            if (collectCounters){
+                counters.reset(new PerfCounters(getAllowedCpus()));
+                context.counters = counters.get();
+                counters->start();
+            }
+            BenchmarkSample sample = benchmark.run(context);
+            context.counters = nullptr;
+            context.unpinThread();
+            if (counters){
+                counters->stop();
+                addCounterMetrics(sample, counters->read());
+            }
+            if (sample.skipped){
+                skipped = true;
+                skipReason = sample.skipReason;
+                break;
+            }
+            result.operations = sample.operations;
+            result.samples.push_back((double)sample.nanoseconds/std::max<uint64_t>(sample.operations, 1));
+            for (auto const &kvpair : sample.metrics){
+                metrics[kvpair.first].push_back(kvpair.second);
+            }
+        }
+        if (skipped){
+            log << std::left << std::setw(64) << result.name << std::right << std::setw(12) << "skipped"
+                << (skipReason.empty() ? "" : "  (" + skipReason + ")") << std::endl;
+            continue;
+        }
+        result.statistics = computeStatistics(result.samples);
+        for (auto const &kvpair : metrics){
+            result.metrics[kvpair.first] = computeStatistics(kvpair.second).median;
+        }
+        log << std::left << std::setw(64) << result.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << result.statistics.median << " " << result.unit
+            << "  (p10 " << result.statistics.p10 << ", p90 " << result.statistics.p90 << ")"
+            << (result.countersComplete ? "" : "  [counters miss pool threads]") << std::endl;
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+BenchmarkStatistics computeStatistics(std::vector<double> samples) {
+    BenchmarkStatistics statistics;
+    if (samples.empty()) return statistics;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (auto s : samples) sum += s;
+    statistics.mean = sum/samples.size();
+    double squares = 0;
+    for (auto s : samples) squares += (s - statistics.mean)*(s - statistics.mean);
+    statistics.stddev = std::sqrt(squares/samples.size());
+    statistics.min = samples.front();
+    statistics.max = samples.back();
+    statistics.median = interpolate(samples, 50);
+    statistics.p10 = interpolate(samples, 10);
+    statistics.p90 = interpolate(samples, 90);
+    return statistics;
+}
+
+void writeJson(const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options, std::ostream& out) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    out << std::setprecision(6);
+    out << "{\n\"context\":{\"date\":\"" << date << "\",\"cpus\":" << getAllowedCpus().size()
+        << ",\"warmup\":" << options.warmup << ",\"repetitions\":" << options.repetitions
+        << ",\"scale\":" << options.scale << ",\"pinned\":" << (options.pin ? "true" : "false")
+        << ",\"counters\":\"" << PerfCounters::getScopeName(getCounterScope(options)) << "\"},\n";
+    out << "\"benchmarks\":[\n";
+    //one benchmark per line, which readBaseline relies on
+    for (size_t i=0; i<results.size(); ++i){
+        auto const &r = results[i];
+        out << "{\"name\":\"" << r.name << "\",\"parameters\":";
+        writeParameters(r.parameters, out);
+        out << ",\"operations\":" << r.operations << ",\"unit\":\"" << r.unit << "\""
+            << ",\"median\":" << r.statistics.median << ",\"mean\":" << r.statistics.mean
+            << ",\"min\":" << r.statistics.min << ",\"max\":" << r.statistics.max
+            << ",\"p10\":" << r.statistics.p10 << ",\"p90\":" << r.statistics.p90
+            << ",\"stddev\":" << r.statistics.stddev << ",\"counters_complete\":" << (r.countersComplete ? "true" : "false")
+            << ",\"samples\":[";
+        for (size_t j=0; j<r.samples.size(); ++j){
+            out << (j ? "," : "") << r.samples[j];
+        }
+        out << "],\"metrics\":{";
+        size_t j = 0;
+        for (auto const &kvpair : r.metrics){
+            out << (j++ ? "," : "") << "\"" << kvpair.first << "\":" << kvpair.second;
+        }
+        out << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n}\n";
+}
+
+std::map<std::string, double> readBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("unable to open baseline " + path);
+    std::map<std::string, double> medians;
+    const std::string namePrefix = "{\"name\":\"";
+    const std::string medianKey = "\"median\":";
+    std::string line;
+    while (std::getline(file, line)){
+        if (line.compare(0, namePrefix.size(), namePrefix) != 0) continue;
+        size_t nameEnd = line.find('"', namePrefix.size());
+        size_t median = line.find(medianKey);
+        if (nameEnd == std::string::npos || median == std::string::npos){
+            throw std::runtime_error("malformed benchmark in baseline " + path);
+        }
+        medians[line.substr(namePrefix.size(), nameEnd - namePrefix.size())] = std::strtod(line.c_str() + median + medianKey.size(), nullptr);
+    }
+    return medians;
+}
+
+std::map<std::string, double> getMedians(const std::vector<BenchmarkResult>& results) {
+    std::map<std::string, double> medians;
+    for (auto const &r : results){
+        medians[r.name] = r.statistics.median;
+    }
+    return medians;
+}
+
+uint32_t compareToBaseline(const std::map<std::string, double>& current, const std::map<std::string, double>& baseline, double threshold, std::ostream& out) {
+    uint32_t regressions = 0;
+    uint32_t compared = 0;
+    out << std::fixed << std::setprecision(1);
+    for (auto const &kvpair : current){
+        auto it = baseline.find(kvpair.first);
+        if (it == baseline.end() || it->second <= 0) continue;
+        ++compared;
+        double change = (kvpair.second - it->second)/it->second*100.0;
+        if (change > threshold){
+            ++regressions;
+            out << "REGRESSION  ";
+        }
+        else if (change < -threshold){
+            out << "improvement ";
+        }
+        else continue;
+        out << std::left << std::setw(64) << kvpair.first << std::right
+            << std::setw(12) << it->second << " -> " << std::setw(12) << kvpair.second
+            << " ns/op (" << std::showpos << change << std::noshowpos << "%)" << std::endl;
+    }
+    out << compared << " benchmarks compared, " << regressions << " regressed by more than " << threshold << "%" << std::endl;
+    return regressions;
+}
+
+void addLatencyMetrics(BenchmarkSample& sample, const std::string& prefix, const BSignals::HistogramSnapshot& snapshot) {
+    for (double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}){
+        std::string name = std::to_string(percentile);
+        name.erase(name.find_last_not_of('0') + 1);
+        if (name.back() == '.') name.pop_back();
+        sample.metrics[prefix + "p" + name] = (double)snapshot.getPercentile(percentile);
+    }
+    sample.metrics[prefix + "max"] = (double)snapshot.getMax();
+    sample.metrics[prefix + "mean"] = snapshot.getMean();
+}
+
+const char* getExecutorName(ExecutorScheme scheme) {
+    switch(scheme){
+        case(ExecutorScheme::SYNCHRONOUS):
+            return "synchronous";
+        case(ExecutorScheme::DEFERRED_SYNCHRONOUS):
+            return "deferred_synchronous";
+        case(ExecutorScheme::ASYNCHRONOUS):
+            return "asynchronous";
+        case(ExecutorScheme::STRAND):
+            return "strand";
+        case(ExecutorScheme::THREAD_POOLED):
+            return "thread_pooled";
+        case(ExecutorScheme::SINGLE_PRODUCER_STRAND):
+            return "single_producer_strand";
+        case(ExecutorScheme::DEFERRED_BUFFERED):
+            return "deferred_buffered";
+        case(ExecutorScheme::KEYED_STRAND):
+            return "keyed_strand";
+        case(ExecutorScheme::PARALLEL_SYNCHRONOUS):
+            return "parallel_synchronous";
+    }
+    return "unknown";
+}
@@ -0,0 +1,175 @@
+/*
+ * File:   Benchmark.h
+ * Author: Barath Kannan
+ * Harness of the benchmark binary. Each benchmark is run for a number of
+ * warm-up repetitions, which are discarded, and then for the measured
+ * repetitions, from which the median and percentiles of the time per
+ * operation are reported. Results can be written as JSON, and compared
+ * against a baseline written by an earlier run.
+ * Created on 20 October 2026, 6:40 AM
+ */
+
+#ifndef BSIGNALS_BENCHMARK_H
+#define BSIGNALS_BENCHMARK_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <ostream>
+#include <cstdint>
+#include "BSignals/ExecutorScheme.h"
+#include "BSignals/Metrics.h"
+
+class PerfCounters;
+
+struct BenchmarkOptions{
+    uint32_t warmup{1};
+    uint32_t repetitions{5};
+    //multiplies the number of operations in each repetition
+    double scale{1.0};
+    //threads of a benchmark are pinned to cpus, in order (the calling thread
+    //to the first); threads created by the library itself are not
+    bool pin{true};
+    //defaults to every cpu the process may run on
+    std::vector<uint32_t> cpus;
+    //comma separated, a benchmark runs if its name contains any of them
+    std::string filter;
+    //performance counters per operation, for benchmarks reported in ns/op
+    bool counters{true};
+};
+
+//one repetition of a benchmark
+struct BenchmarkSample{
+    uint64_t nanoseconds{0};
+    uint64_t operations{0};
+    //further values reported by the benchmark, by name
+    std::map<std::string, double> metrics;
+    //a benchmark which can't be run meaningfully (e.g. a load beyond the
+    //saturation of a lower one) is skipped, and left out of the results
+    bool skipped{false};
+    //logged with a skipped benchmark
+    std::string skipReason;
+};
+
+class BenchmarkContext{
+public:
+    BenchmarkContext(const BenchmarkOptions& o) : options(o){}
+
+    //pins the calling thread to the cpu for thread index (0 for the calling
+    //thread of the benchmark), if pinning is enabled
+    void pinThread(uint32_t index) const;
+
+    //restores the calling thread to every cpu
+    void unpinThread() const;
+
+    //operations per repetition, scaled by the options (at least 1)
+    uint64_t scaled(uint64_t operations) const;
+
+    //true during the discarded warm-up repetitions
+    bool isWarmup() const{
+        return warmup;
+    }
+
+    //bracket the measured region of a repetition, so that performance
+    //counters leave out its setup and teardown (without them, counters
+    //cover the whole repetition)
+    void beginMeasurement() const;
+    void endMeasurement() const;
+
+    const BenchmarkOptions& options;
+
+private:
+    friend class BenchmarkRegistry;
+
+    //counters of the current repetition, if any
+    PerfCounters* counters{nullptr};
+    bool warmup{false};
+};
+
+struct Benchmark{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    //of nanoseconds over operations, for benchmarks which report something
+    //other than the time per operation
+    std::string unit{"ns/op"};
+    //set if work runs on threads which exist before the repetition starts
+    //(the thread pool's workers), which thread scoped counters can't see
+    bool usesPersistentThreads{false};
+    std::function<BenchmarkSample(const BenchmarkContext&)> run;
+};
+
+//nanoseconds per operation (or the benchmark's unit) across the measured repetitions
+struct BenchmarkStatistics{
+    double median{0};
+    double mean{0};
+    double min{0};
+    double max{0};
+    double p10{0};
+    double p90{0};
+    double stddev{0};
+};
+
+struct BenchmarkResult{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    std::string unit;
+    uint64_t operations{0};
+    std::vector<double> samples;
+    BenchmarkStatistics statistics;
+    //median of each metric across the measured repetitions
+    std::map<std::string, double> metrics;
+    //false if performance counters missed threads the benchmark used
+    bool countersComplete{true};
+};
+
+class BenchmarkRegistry{
+public:
+    void add(Benchmark benchmark);
+
+    std::vector<std::string> getNames(const std::string& filter) const;
+
+    //runs every benchmark matching the filter, logging progress to log
+    std::vector<BenchmarkResult> run(const BenchmarkOptions& options, std::ostream& log) const;
+
+private:
+    std::vector<Benchmark> benchmarks;
+};
+
+//statistics of a set of samples (percentiles are interpolated)
+BenchmarkStatistics computeStatistics(std::vector<double> samples);
+
+void writeJson(const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options, std::ostream& out);
+
+//median nanoseconds per operation by benchmark name, from a file written by
+//writeJson; throws std::runtime_error if the file can't be read
+std::map<std::string, double> readBaseline(const std::string& path);
+
+std::map<std::string, double> getMedians(const std::vector<BenchmarkResult>& results);
+
+//reports benchmarks whose median is more than threshold percent slower than
+//in the baseline, returning the number of regressions
+uint32_t compareToBaseline(const std::map<std::string, double>& current, const std::map<std::string, double>& baseline, double threshold, std::ostream& out);
+
+const char* getExecutorName(BSignals::ExecutorScheme scheme);
+
+//cpus the process was allowed to run on when it started
+const std::vector<uint32_t>& getAllowedCpus();
+
+//adds the p50 to p99.99, max and mean of snapshot to the metrics of sample,
+//each name prefixed by prefix
+void addLatencyMetrics(BenchmarkSample& sample, const std::string& prefix, const BSignals::HistogramSnapshot& snapshot);
+
+//keeps the compiler from optimizing away a value
+template <typename T>
+inline void doNotOptimize(const T& value){
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+//registration of each suite, called by main
+void registerSignalBenchmarks(BenchmarkRegistry& registry);
+void registerLatencyBenchmarks(BenchmarkRegistry& registry);
+void registerPrimitiveBenchmarks(BenchmarkRegistry& registry);
+
+#endif /* BSIGNALS_BENCHMARK_H */
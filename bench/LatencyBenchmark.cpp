@@ -0,0 +1,161 @@
+#include "Benchmark.h"
+#include "TscClock.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/details/LatencyHistogram.h"
+
+using BSignals::Signal;
+using BSignals::ExecutorScheme;
+using BSignals::HistogramSnapshot;
+using BSignals::details::LatencyHistogram;
+
+namespace{
+
+//carried by each emission, in clock ticks
+struct Stamp{
+    //when the emission was scheduled to be made
+    uint64_t intended;
+    //when it was actually made
+    uint64_t sent;
+};
+
+//emissions per second of each load, each run until a load saturates
+const uint64_t targetRates[] = {10000, 20000, 50000, 100000, 200000, 500000, 1000000, 2000000};
+//length of each load, before scaling
+const uint64_t loadMilliseconds = 100;
+//a load is saturated if its emissions aren't executed at this fraction of its rate
+const double saturationThreshold = 0.95;
+//the emitter yields while the next emission is further away than this
+const double yieldNanoseconds = 20000;
+
+bool isDeferred(ExecutorScheme scheme){
+    return (scheme == ExecutorScheme::DEFERRED_SYNCHRONOUS || scheme == ExecutorScheme::DEFERRED_BUFFERED);
+}
+
+//loads of one scheme, run in order of rate. Once every measured repetition
+//of a rate has run, the rate is saturated if the median fraction of it that
+//was achieved is below the threshold, and higher rates are skipped
+struct LoadState{
+    uint64_t rate{0};
+    //achieved over target rate, of each measured repetition of rate
+    std::vector<double> achieved;
+    //the first saturated rate, or 0
+    uint64_t saturatedRate{0};
+
+    //called before each repetition of rate, returns false if it's skipped
+    bool begin(uint64_t nextRate){
+        if (nextRate != rate && !achieved.empty()){
+            std::sort(achieved.begin(), achieved.end());
+            if (achieved[achieved.size()/2] < saturationThreshold) saturatedRate = rate;
+            achieved.clear();
+        }
+        rate = nextRate;
+        return (saturatedRate == 0);
+    }
+};
+
+//open loop: emissions are made on a fixed schedule, regardless of how long
+//earlier emissions took, and latency is measured from when each emission
+//was scheduled rather than when it was made. An emitter held up by a slow
+//emission therefore can't hide the delay from the emissions queued behind
+//it (coordinated omission); the latency from when emissions were actually
+//made is reported alongside as uncorrected
+BenchmarkSample runLoad(const BenchmarkContext& context, ExecutorScheme scheme, uint64_t rate, LoadState& state){
+    BenchmarkSample sample;
+    if (!state.begin(rate)){
+        sample.skipped = true;
+        sample.skipReason = "saturated at rate:" + std::to_string(state.saturatedRate);
+        return sample;
+    }
+    const uint64_t nEmissions = context.scaled(rate*loadMilliseconds/1000);
+    auto corrected = std::make_unique<LatencyHistogram>();
+    auto uncorrected = std::make_unique<LatencyHistogram>();
+    std::atomic<uint64_t> executed{0};
+
+    Signal<Stamp> signal;
+    auto slot = [&](Stamp stamp){
+        uint64_t now = TscClock::now();
+        corrected->record(TscClock::toNanoseconds(now > stamp.intended ? now - stamp.intended : 0));
+        uncorrected->record(TscClock::toNanoseconds(now > stamp.sent ? now - stamp.sent : 0));
+        executed.fetch_add(1, std::memory_order_release);
+    };
+    //stamps can't be hashed, each emission is keyed by its scheduled time
+    if (scheme == ExecutorScheme::KEYED_STRAND) signal.connectKeyedSlot([](const Stamp& stamp){return std::hash<uint64_t>()(stamp.intended);}, slot);
+    else signal.connectSlot(scheme, slot);
+    std::atomic<bool> stop{false};
+    std::thread invoker;
+    if (isDeferred(scheme)){
+        invoker = std::thread([&signal, &stop, &executed](){
+            while (!stop.load(std::memory_order_relaxed)){
+                uint64_t before = executed.load(std::memory_order_relaxed);
+                signal.invokeDeferred(1024);
+                if (executed.load(std::memory_order_relaxed) == before) std::this_thread::yield();
+            }
+        });
+    }
+
+    context.pinThread(0);
+    const double intervalNanoseconds = 1e9/rate;
+    const uint64_t yieldTicks = TscClock::fromNanoseconds(yieldNanoseconds);
+    const uint64_t start = TscClock::now() + TscClock::fromNanoseconds(1e6);
+    for (uint64_t i=0; i<nEmissions; ++i){
+        uint64_t intended = start + TscClock::fromNanoseconds(i*intervalNanoseconds);
+        for (;;){
+            uint64_t now = TscClock::now();
+            if (now >= intended) break;
+            if (intended - now > yieldTicks) std::this_thread::yield();
+        }
+        signal.emitSignal(Stamp{intended, TscClock::now()});
+    }
+    while (executed.load(std::memory_order_acquire) < nEmissions) std::this_thread::yield();
+    const uint64_t end = TscClock::now();
+    stop.store(true);
+    if (invoker.joinable()) invoker.join();
+
+    double achievedRate = nEmissions/(TscClock::toNanoseconds(end - start)/1e9);
+    //a noisy warm-up doesn't skip the measured repetitions
+    if (!context.isWarmup()) state.achieved.push_back(achievedRate/rate);
+    HistogramSnapshot latency = corrected->snapshot();
+    //reported as the time per operation, so that baselines compare the p99
+    sample.nanoseconds = latency.getPercentile(99);
+    sample.operations = 1;
+    addLatencyMetrics(sample, "", latency);
+    addLatencyMetrics(sample, "uncorrected_", uncorrected->snapshot());
+    sample.metrics["target_rate"] = (double)rate;
+    sample.metrics["achieved_rate"] = achievedRate;
+    sample.metrics["saturated"] = (achievedRate < saturationThreshold*rate ? 1 : 0);
+    sample.metrics["emissions"] = (double)nEmissions;
+    return sample;
+}
+
+}
+
+void registerLatencyBenchmarks(BenchmarkRegistry& registry){
+    const ExecutorScheme schemes[] = {
+        ExecutorScheme::SYNCHRONOUS, ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED,
+        ExecutorScheme::ASYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::SINGLE_PRODUCER_STRAND,
+        ExecutorScheme::THREAD_POOLED, ExecutorScheme::KEYED_STRAND, ExecutorScheme::PARALLEL_SYNCHRONOUS
+    };
+    for (auto scheme : schemes){
+        //loads above the first to saturate are skipped
+        auto state = std::make_shared<LoadState>();
+        for (auto rate : targetRates){
+            Benchmark benchmark;
+            benchmark.name = std::string("latency/") + getExecutorName(scheme) + "/rate:" + std::to_string(rate);
+            benchmark.parameters = {
+                {"executor", getExecutorName(scheme)},
+                {"rate", std::to_string(rate)}
+            };
+            benchmark.unit = "ns p99 latency";
+            benchmark.run = [scheme, rate, state](const BenchmarkContext& context){
+                return runLoad(context, scheme, rate, *state);
+            };
+            registry.add(std::move(benchmark));
+        }
+    }
+}
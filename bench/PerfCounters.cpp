@@ -0,0 +1,172 @@
+#include "PerfCounters.h"
+#include <cstring>
+#include <algorithm>
+
+#ifdef LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace{
+
+struct CounterType{
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+};
+
+const CounterType counterTypes[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"llc_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"context_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}
+};
+
+int openCounter(const CounterType& counterType, int pid, int cpu, bool inherit){
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counterType.type;
+    attr.config = counterType.config;
+    attr.disabled = 1;
+    attr.inherit = (inherit ? 1 : 0);
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int fd = (int)syscall(__NR_perf_event_open, &attr, pid, cpu, -1, 0);
+    if (fd >= 0) return fd;
+    //unprivileged processes may only count user space
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, pid, cpu, -1, 0);
+}
+
+}
+#endif
+
+PerfCounters::PerfCounters(const std::vector<uint32_t>& cpus) {
+    if (!open(Scope::SYSTEM, cpus)) open(Scope::THREAD, cpus);
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+#ifdef LINUX
+bool PerfCounters::open(Scope s, const std::vector<uint32_t>& cpus) {
+    for (auto const &counterType : counterTypes){
+        Counter counter;
+        counter.name = counterType.name;
+        bool opened = true;
+        if (s == Scope::SYSTEM){
+            for (auto cpu : cpus){
+                int fd = openCounter(counterType, -1, (int)cpu, false);
+                if (fd < 0){
+                    opened = false;
+                    break;
+                }
+                counter.fds.push_back(fd);
+            }
+        }
+        else{
+            int fd = openCounter(counterType, 0, -1, true);
+            if (fd < 0) opened = false;
+            else counter.fds.push_back(fd);
+        }
+        if (opened) counters.push_back(std::move(counter));
+        else for (auto fd : counter.fds) ::close(fd);
+    }
+    if (!counters.empty()) scope = s;
+    return !counters.empty();
+}
+#else
+//perf_event_open is linux only, so the scope stays NONE
+bool PerfCounters::open(Scope, const std::vector<uint32_t>&) {
+    return false;
+}
+#endif
+
+void PerfCounters::close() {
+#ifdef LINUX
+    for (auto const &counter : counters){
+        for (auto fd : counter.fds) ::close(fd);
+    }
+#endif
+    counters.clear();
+    scope = Scope::NONE;
+}
+
+void PerfCounters::start() {
+#ifdef LINUX
+    for (auto const &counter : counters){
+        for (auto fd : counter.fds){
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+    baseline = readTotals();
+}
+
+void PerfCounters::stop() {
+#ifdef LINUX
+    for (auto const &counter : counters){
+        for (auto fd : counter.fds) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+std::map<std::string, double> PerfCounters::read() const {
+    std::map<std::string, double> values = readTotals();
+    for (auto &kvpair : values){
+        auto it = baseline.find(kvpair.first);
+        if (it != baseline.end()) kvpair.second = std::max(0.0, kvpair.second - it->second);
+    }
+    return values;
+}
+
+std::map<std::string, double> PerfCounters::readTotals() const {
+    std::map<std::string, double> values;
+#ifdef LINUX
+    for (auto const &counter : counters){
+        double total = 0;
+        bool valid = true;
+        for (auto fd : counter.fds){
+            //value, time enabled, time running
+            uint64_t data[3];
+            if (::read(fd, data, sizeof(data)) != (ssize_t)sizeof(data)){
+                valid = false;
+                break;
+            }
+            if (data[2] == 0) continue;
+            total += (double)data[0]*data[1]/data[2];
+        }
+        if (valid) values[counter.name] = total;
+    }
+#endif
+    return values;
+}
+
+const char* PerfCounters::getScopeName(Scope scope) {
+    switch(scope){
+        case(Scope::NONE):
+            return "none";
+        case(Scope::THREAD):
+            return "thread";
+        case(Scope::SYSTEM):
+            return "system";
+    }
+    return "unknown";
+}
+
+const char* PerfCounters::getScopeDescription(Scope scope) {
+    switch(scope){
+        case(Scope::NONE):
+            return "unavailable";
+        case(Scope::THREAD):
+            return "threads created by each repetition, excluding the thread pool's workers";
+        case(Scope::SYSTEM):
+            return "every process running on the measured cpus";
+    }
+    return "unknown";
+}
@@ -0,0 +1,77 @@
+/*
+ * File:   PerfCounters.h
+ * Author: Barath Kannan
+ * Hardware and software performance counters from perf_event_open, read
+ * around the measured region of each benchmark repetition. Counters are
+ * opened on every cpu the process may run on where permitted, which counts
+ * every thread including those of the thread pool, and every other process
+ * running on those cpus. Otherwise they're opened on the calling thread and
+ * inherited by threads it creates afterwards (a thread's counts are only
+ * added once it exits), which misses threads that already existed, such as
+ * the thread pool's workers. Counters the kernel or hardware doesn't
+ * support are left out, so none at all may be available (and none are on
+ * hosts other than linux).
+ * Created on 20 October 2026, 7:30 AM
+ */
+
+#ifndef BSIGNALS_PERFCOUNTERS_H
+#define BSIGNALS_PERFCOUNTERS_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class PerfCounters{
+public:
+    enum class Scope{
+        //nothing could be opened
+        NONE,
+        //every thread created after opening, by the calling thread
+        THREAD,
+        //everything running on the cpus
+        SYSTEM
+    };
+
+    //opens the counters, disabled
+    PerfCounters(const std::vector<uint32_t>& cpus);
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    void operator=(const PerfCounters&) = delete;
+
+    //resets and enables the counters
+    void start();
+
+    void stop();
+
+    //counts since start by counter name, scaled up where the kernel had to
+    //multiplex the counters; counters which couldn't be opened are absent
+    std::map<std::string, double> read() const;
+
+    //description of what the scope counts, for reporting
+    static const char* getScopeDescription(Scope scope);
+
+    Scope getScope() const{
+        return scope;
+    }
+
+    static const char* getScopeName(Scope scope);
+
+private:
+    struct Counter{
+        std::string name;
+        std::vector<int> fds;
+    };
+
+    bool open(Scope s, const std::vector<uint32_t>& cpus);
+    void close();
+    std::map<std::string, double> readTotals() const;
+
+    std::vector<Counter> counters;
+    //totals when started, as a reset leaves the counts of exited
+    //inheriting threads in place
+    std::map<std::string, double> baseline;
+    Scope scope{Scope::NONE};
+};
+
+#endif /* BSIGNALS_PERFCOUNTERS_H */
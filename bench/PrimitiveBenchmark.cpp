@@ -0,0 +1,494 @@
+#include "Benchmark.h"
+#include "TscClock.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "BSignals/details/MPSCQueue.hpp"
+#include "BSignals/details/ContiguousMPMCQueue.hpp"
+#include "BSignals/details/DynamicMPMCQueue.hpp"
+#include "BSignals/details/SharedMutex.h"
+#include "BSignals/details/Semaphore.h"
+#include "BSignals/details/Wheel.hpp"
+#include "BSignals/details/LatencyHistogram.h"
+
+using BSignals::details::MPSCQueue;
+using BSignals::details::ContiguousMPMCQueue;
+using BSignals::details::DynamicMPMCQueue;
+using BSignals::details::MPMCLayout;
+using BSignals::details::SharedMutex;
+using BSignals::details::Semaphore;
+using BSignals::details::Wheel;
+using BSignals::details::LatencyHistogram;
+
+namespace{
+
+enum class Load{
+    STEADY,
+    //operations in bursts, with the threads idle in between
+    BURST
+};
+
+const char* getLoadName(Load load){
+    return (load == Load::STEADY ? "steady" : "burst");
+}
+
+const uint32_t burstSize = 64;
+const auto burstPause = std::chrono::microseconds(50);
+
+//operations per repetition across every thread, before scaling
+const uint64_t queueBudget = 100000;
+const uint64_t lockBudget = 200000;
+const uint64_t semaphoreBudget = 100000;
+const uint64_t wheelBudget = 400000;
+
+const uint32_t threadCounts[] = {1, 4, 16, 64};
+
+//of the bounded queues
+const size_t queueCapacity = 1024;
+
+inline void pace(Load load, uint64_t operation){
+    if (load == Load::BURST && (operation + 1) % burstSize == 0) std::this_thread::sleep_for(burstPause);
+}
+
+inline uint64_t elapsedNanoseconds(uint64_t start){
+    uint64_t now = TscClock::now();
+    return TscClock::toNanoseconds(now > start ? now - start : 0);
+}
+
+//runs func(index) on nThreads threads, each pinned in turn, returning the
+//time from when they're released together until the last has finished
+template <typename F>
+uint64_t runThreads(const BenchmarkContext& context, uint32_t nThreads, F&& func){
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (uint32_t i=0; i<nThreads; ++i){
+        threads.emplace_back([&, i](){
+            context.pinThread(i + 1);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            func(i);
+        });
+    }
+    context.pinThread(0);
+    while (ready.load() < nThreads) std::this_thread::yield();
+    context.beginMeasurement();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &t : threads) t.join();
+    uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    context.endMeasurement();
+    return nanoseconds;
+}
+
+BenchmarkSample makeSample(uint64_t nanoseconds, uint64_t operations, const LatencyHistogram& latency){
+    BenchmarkSample sample;
+    sample.nanoseconds = nanoseconds;
+    sample.operations = operations;
+    sample.metrics["ops_per_second"] = operations*1e9/std::max<uint64_t>(nanoseconds, 1);
+    addLatencyMetrics(sample, "latency_", latency.snapshot());
+    return sample;
+}
+
+//queues
+
+template <uint32_t Size>
+struct Item{
+    //when the item was enqueued, in clock ticks
+    uint64_t stamp;
+    std::array<uint8_t, Size - sizeof(uint64_t)> data;
+};
+
+//adapters transfer up to n items, returning the number transferred; batch
+//is the most a producer or consumer asks for at once
+template <typename T>
+class MPSCAdapter{
+public:
+    static const uint32_t batch = 1;
+    size_t enqueue(const T* items, size_t){
+        queue.enqueue(*items);
+        return 1;
+    }
+    size_t dequeue(T* items, size_t){
+        return (queue.dequeue(*items) ? 1 : 0);
+    }
+private:
+    MPSCQueue<T> queue;
+};
+
+template <typename T>
+class MPMCAdapter{
+public:
+    static const uint32_t batch = 1;
+    size_t enqueue(const T* items, size_t){
+        return (queue.enqueue(*items) ? 1 : 0);
+    }
+    size_t dequeue(T* items, size_t){
+        return (queue.dequeue(*items) ? 1 : 0);
+    }
+private:
+    ContiguousMPMCQueue<T, queueCapacity> queue;
+};
+
+//each cell layout, optionally with the bulk api
+template <typename T, MPMCLayout L, bool Bulk>
+class DynamicAdapter{
+public:
+    static const uint32_t batch = (Bulk ? 16 : 1);
+    size_t enqueue(const T* items, size_t n){
+        if (Bulk) return queue.enqueue_n(items, n);
+        return (queue.enqueue(*items) ? 1 : 0);
+    }
+    size_t dequeue(T* items, size_t n){
+        if (Bulk) return queue.dequeue_n(items, n);
+        return (queue.dequeue(*items) ? 1 : 0);
+    }
+private:
+    DynamicMPMCQueue<T, L> queue{queueCapacity};
+};
+
+//reference queue
+template <typename T>
+class LockedQueue{
+public:
+    static const uint32_t batch = 1;
+    size_t enqueue(const T* items, size_t){
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(*items);
+        return 1;
+    }
+    size_t dequeue(T* items, size_t){
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return 0;
+        *items = queue.front();
+        queue.pop_front();
+        return 1;
+    }
+private:
+    std::mutex mutex;
+    std::deque<T> queue;
+};
+
+//latency is from enqueue (including retries while a bounded queue is full)
+//until dequeue
+template <typename Q, typename T>
+BenchmarkSample runQueue(const BenchmarkContext& context, uint32_t nProducers, uint32_t nConsumers, Load load){
+    const uint64_t perProducer = std::max<uint64_t>(1, context.scaled(queueBudget)/nProducers);
+    const uint64_t total = perProducer*nProducers;
+    auto queue = std::make_unique<Q>();
+    auto latency = std::make_unique<LatencyHistogram>();
+    std::atomic<uint64_t> consumed{0};
+    uint64_t nanoseconds = runThreads(context, nProducers + nConsumers, [&](uint32_t index){
+        std::vector<T> items(Q::batch);
+        if (index < nProducers){
+            for (uint64_t i=0; i<perProducer;){
+                size_t n = std::min<uint64_t>(Q::batch, perProducer - i);
+                uint64_t stamp = TscClock::now();
+                for (size_t j=0; j<n; ++j) items[j].stamp = stamp;
+                for (size_t done=0; done<n;){
+                    size_t pushed = queue->enqueue(items.data() + done, n - done);
+                    if (!pushed) std::this_thread::yield();
+                    done += pushed;
+                }
+                for (size_t j=0; j<n; ++j) pace(load, i + j);
+                i += n;
+            }
+            return;
+        }
+        while (consumed.load(std::memory_order_relaxed) < total){
+            size_t n = queue->dequeue(items.data(), Q::batch);
+            if (!n){
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t j=0; j<n; ++j) latency->record(elapsedNanoseconds(items[j].stamp));
+            consumed.fetch_add(n, std::memory_order_relaxed);
+        }
+    });
+    return makeSample(nanoseconds, total, *latency);
+}
+
+template <uint32_t Size>
+void registerQueues(BenchmarkRegistry& registry){
+    typedef Item<Size> T;
+    const std::pair<uint32_t, uint32_t> threads[] = {{1, 1}, {4, 1}, {16, 1}, {64, 1}, {1, 4}, {4, 4}, {16, 16}, {64, 64}};
+    for (auto const &kvpair : threads){
+        uint32_t nProducers = kvpair.first, nConsumers = kvpair.second;
+        for (auto load : {Load::STEADY, Load::BURST}){
+            auto add = [&](const std::string& queueName, std::function<BenchmarkSample(const BenchmarkContext&)> run){
+                Benchmark benchmark;
+                benchmark.name = "primitive/queue/" + queueName + "/producers:" + std::to_string(nProducers)
+                    + "/consumers:" + std::to_string(nConsumers) + "/load:" + getLoadName(load) + "/payload:" + std::to_string(Size);
+                benchmark.parameters = {
+                    {"primitive", "queue"},
+                    {"implementation", queueName},
+                    {"producers", std::to_string(nProducers)},
+                    {"consumers", std::to_string(nConsumers)},
+                    {"load", getLoadName(load)},
+                    {"payload", std::to_string(Size)}
+                };
+                benchmark.run = std::move(run);
+                registry.add(std::move(benchmark));
+            };
+            //a single consumer only
+            if (nConsumers == 1){
+                add("mpsc", [=](const BenchmarkContext& context){
+                    return runQueue<MPSCAdapter<T>, T>(context, nProducers, nConsumers, load);
+                });
+            }
+            add("mpmc", [=](const BenchmarkContext& context){
+                return runQueue<MPMCAdapter<T>, T>(context, nProducers, nConsumers, load);
+            });
+            //the cell layouts of DynamicMPMCQueue
+            add("dynamic_compact", [=](const BenchmarkContext& context){
+                return runQueue<DynamicAdapter<T, MPMCLayout::COMPACT, false>, T>(context, nProducers, nConsumers, load);
+            });
+            add("dynamic_padded", [=](const BenchmarkContext& context){
+                return runQueue<DynamicAdapter<T, MPMCLayout::PADDED, false>, T>(context, nProducers, nConsumers, load);
+            });
+            add("dynamic_scrambled", [=](const BenchmarkContext& context){
+                return runQueue<DynamicAdapter<T, MPMCLayout::SCRAMBLED, false>, T>(context, nProducers, nConsumers, load);
+            });
+            add("dynamic_padded_bulk", [=](const BenchmarkContext& context){
+                return runQueue<DynamicAdapter<T, MPMCLayout::PADDED, true>, T>(context, nProducers, nConsumers, load);
+            });
+            add("locked", [=](const BenchmarkContext& context){
+                return runQueue<LockedQueue<T>, T>(context, nProducers, nConsumers, load);
+            });
+        }
+    }
+}
+
+//shared mutexes
+
+//reference exclusive lock, taken exclusively by readers as well
+class ExclusiveMutex{
+public:
+    void lock(){ mutex.lock(); }
+    void unlock(){ mutex.unlock(); }
+    void lock_shared(){ mutex.lock(); }
+    void unlock_shared(){ mutex.unlock(); }
+private:
+    std::mutex mutex;
+};
+
+//latency is from requesting the lock until it's held
+template <typename L>
+BenchmarkSample runLock(const BenchmarkContext& context, uint32_t nThreads, uint32_t readPercent, Load load){
+    const uint64_t perThread = std::max<uint64_t>(1, context.scaled(lockBudget)/nThreads);
+    L mutex;
+    std::array<uint64_t, 8> guarded{};
+    auto latency = std::make_unique<LatencyHistogram>();
+    uint64_t nanoseconds = runThreads(context, nThreads, [&](uint32_t index){
+        for (uint64_t i=0; i<perThread; ++i){
+            uint64_t start = TscClock::now();
+            //spreads the writes evenly through each thread's operations
+            if ((i*37 + index*11) % 100 < readPercent){
+                mutex.lock_shared();
+                latency->record(elapsedNanoseconds(start));
+                uint64_t sum = 0;
+                for (auto value : guarded) sum += value;
+                mutex.unlock_shared();
+                doNotOptimize(sum);
+            }
+            else{
+                mutex.lock();
+                latency->record(elapsedNanoseconds(start));
+                ++guarded[i % guarded.size()];
+                mutex.unlock();
+            }
+            pace(load, i);
+        }
+    });
+    return makeSample(nanoseconds, perThread*nThreads, *latency);
+}
+
+void registerLocks(BenchmarkRegistry& registry){
+    for (uint32_t nThreads : threadCounts){
+        for (uint32_t readPercent : {100u, 90u, 50u}){
+            for (auto load : {Load::STEADY, Load::BURST}){
+                auto add = [&](const std::string& lockName, std::function<BenchmarkSample(const BenchmarkContext&)> run){
+                    Benchmark benchmark;
+                    benchmark.name = "primitive/lock/" + lockName + "/threads:" + std::to_string(nThreads)
+                        + "/reads:" + std::to_string(readPercent) + "/load:" + getLoadName(load);
+                    benchmark.parameters = {
+                        {"primitive", "lock"},
+                        {"implementation", lockName},
+                        {"threads", std::to_string(nThreads)},
+                        {"reads", std::to_string(readPercent)},
+                        {"load", getLoadName(load)}
+                    };
+                    benchmark.run = std::move(run);
+                    registry.add(std::move(benchmark));
+                };
+                add("shared_mutex", [=](const BenchmarkContext& context){
+                    return runLock<SharedMutex>(context, nThreads, readPercent, load);
+                });
+                //std::shared_mutex is C++17, its timed counterpart is the C++14 reference
+                add("std_shared_timed_mutex", [=](const BenchmarkContext& context){
+                    return runLock<std::shared_timed_mutex>(context, nThreads, readPercent, load);
+                });
+                add("std_mutex", [=](const BenchmarkContext& context){
+                    return runLock<ExclusiveMutex>(context, nThreads, readPercent, load);
+                });
+            }
+        }
+    }
+}
+
+//semaphores
+
+//reference semaphore
+class LockedSemaphore{
+public:
+    LockedSemaphore(uint32_t size) : count(size){}
+
+    void acquire(){
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this](){ return count > 0; });
+        --count;
+    }
+
+    void release(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++count;
+        }
+        cv.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t count;
+};
+
+//latency is from acquire being called until it returns
+template <typename S>
+BenchmarkSample runSemaphore(const BenchmarkContext& context, uint32_t nThreads, uint32_t permits, Load load){
+    const uint64_t perThread = std::max<uint64_t>(1, context.scaled(semaphoreBudget)/nThreads);
+    S semaphore(permits);
+    auto latency = std::make_unique<LatencyHistogram>();
+    uint64_t nanoseconds = runThreads(context, nThreads, [&](uint32_t){
+        for (uint64_t i=0; i<perThread; ++i){
+            uint64_t start = TscClock::now();
+            semaphore.acquire();
+            latency->record(elapsedNanoseconds(start));
+            semaphore.release();
+            pace(load, i);
+        }
+    });
+    return makeSample(nanoseconds, perThread*nThreads, *latency);
+}
+
+void registerSemaphores(BenchmarkRegistry& registry){
+    for (uint32_t nThreads : threadCounts){
+        for (uint32_t permits : {1u, 8u}){
+            for (auto load : {Load::STEADY, Load::BURST}){
+                auto add = [&](const std::string& semaphoreName, std::function<BenchmarkSample(const BenchmarkContext&)> run){
+                    Benchmark benchmark;
+                    benchmark.name = "primitive/semaphore/" + semaphoreName + "/threads:" + std::to_string(nThreads)
+                        + "/permits:" + std::to_string(permits) + "/load:" + getLoadName(load);
+                    benchmark.parameters = {
+                        {"primitive", "semaphore"},
+                        {"implementation", semaphoreName},
+                        {"threads", std::to_string(nThreads)},
+                        {"permits", std::to_string(permits)},
+                        {"load", getLoadName(load)}
+                    };
+                    benchmark.run = std::move(run);
+                    registry.add(std::move(benchmark));
+                };
+                add("semaphore", [=](const BenchmarkContext& context){
+                    return runSemaphore<Semaphore>(context, nThreads, permits, load);
+                });
+                add("locked", [=](const BenchmarkContext& context){
+                    return runSemaphore<LockedSemaphore>(context, nThreads, permits, load);
+                });
+            }
+        }
+    }
+}
+
+//wheels
+
+const uint32_t wheelSpokes = 8;
+
+//reference wheel, with the spoke index under a mutex
+class LockedWheel{
+public:
+    uint64_t& getSpoke(){
+        std::lock_guard<std::mutex> lock(mutex);
+        uint32_t index = current;
+        current = (current + 1 == wheelSpokes ? 0 : current + 1);
+        return spokes[index];
+    }
+private:
+    std::mutex mutex;
+    uint32_t current{0};
+    std::array<uint64_t, wheelSpokes> spokes{};
+};
+
+//latency is of getting the next spoke
+template <typename W>
+BenchmarkSample runWheel(const BenchmarkContext& context, uint32_t nThreads, Load load){
+    const uint64_t perThread = std::max<uint64_t>(1, context.scaled(wheelBudget)/nThreads);
+    auto wheel = std::make_unique<W>();
+    auto latency = std::make_unique<LatencyHistogram>();
+    uint64_t nanoseconds = runThreads(context, nThreads, [&](uint32_t){
+        for (uint64_t i=0; i<perThread; ++i){
+            uint64_t start = TscClock::now();
+            uint64_t& spoke = wheel->getSpoke();
+            latency->record(elapsedNanoseconds(start));
+            doNotOptimize(spoke);
+            pace(load, i);
+        }
+    });
+    return makeSample(nanoseconds, perThread*nThreads, *latency);
+}
+
+void registerWheels(BenchmarkRegistry& registry){
+    for (uint32_t nThreads : threadCounts){
+        for (auto load : {Load::STEADY, Load::BURST}){
+            auto add = [&](const std::string& wheelName, std::function<BenchmarkSample(const BenchmarkContext&)> run){
+                Benchmark benchmark;
+                benchmark.name = "primitive/wheel/" + wheelName + "/threads:" + std::to_string(nThreads)
+                    + "/load:" + getLoadName(load);
+                benchmark.parameters = {
+                    {"primitive", "wheel"},
+                    {"implementation", wheelName},
+                    {"threads", std::to_string(nThreads)},
+                    {"load", getLoadName(load)}
+                };
+                benchmark.run = std::move(run);
+                registry.add(std::move(benchmark));
+            };
+            add("wheel", [=](const BenchmarkContext& context){
+                return runWheel<Wheel<uint64_t, wheelSpokes>>(context, nThreads, load);
+            });
+            add("locked", [=](const BenchmarkContext& context){
+                return runWheel<LockedWheel>(context, nThreads, load);
+            });
+        }
+    }
+}
+
+}
+
+void registerPrimitiveBenchmarks(BenchmarkRegistry& registry){
+    registerQueues<8>(registry);
+    registerQueues<64>(registry);
+    registerQueues<1024>(registry);
+    registerLocks(registry);
+    registerSemaphores(registry);
+    registerWheels(registry);
+}
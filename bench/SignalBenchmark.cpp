@@ -0,0 +1,323 @@
+#include "Benchmark.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/Instrumentation.h"
+#include "BSignals/Tracing.h"
+
+using BSignals::Signal;
+using BSignals::BasicSignal;
+using BSignals::ExecutorScheme;
+using BSignals::NoInstrumentation;
+using BSignals::CountingInstrumentation;
+using BSignals::TimingInstrumentation;
+using BSignals::TracingInstrumentation;
+
+namespace{
+
+template <uint32_t Size>
+struct Payload{
+    std::array<uint8_t, Size> data;
+};
+
+//padded rather than aligned, as C++14 new doesn't honour extended alignment
+struct SlotCounter{
+    std::atomic<uint64_t> executions{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+//slot executions per repetition, before scaling
+const uint64_t executionBudget = 200000;
+
+bool isDeferred(ExecutorScheme scheme){
+    return (scheme == ExecutorScheme::DEFERRED_SYNCHRONOUS || scheme == ExecutorScheme::DEFERRED_BUFFERED);
+}
+
+//slots executed by the thread pool's workers, which outlive any one benchmark
+bool usesThreadPool(ExecutorScheme scheme){
+    return (scheme == ExecutorScheme::THREAD_POOLED || scheme == ExecutorScheme::KEYED_STRAND || scheme == ExecutorScheme::PARALLEL_SYNCHRONOUS);
+}
+
+//emissions from each emitter, each executing every slot; the time is from
+//the first emission until every slot has executed every emission
+//each execution does operations iterations of dependent arithmetic
+template <typename P>
+BenchmarkSample runEmissions(const BenchmarkContext& context, ExecutorScheme scheme, uint32_t nSlots, uint32_t nEmitters, uint32_t operations = 0){
+    uint64_t budget = context.scaled(executionBudget);
+    //a thread is spawned for every asynchronous execution
+    if (scheme == ExecutorScheme::ASYNCHRONOUS) budget /= 100;
+    const uint64_t perEmitter = std::max<uint64_t>(1, budget/nSlots/nEmitters);
+    const uint64_t expected = perEmitter*nEmitters*nSlots;
+
+    std::unique_ptr<SlotCounter[]> counters(new SlotCounter[nSlots]);
+    Signal<P> signal;
+    for (uint32_t i=0; i<nSlots; ++i){
+        SlotCounter& counter = counters[i];
+        auto slot = [&counter, operations](P p){
+            doNotOptimize(p);
+            uint64_t v = 1;
+            for (uint32_t j=0; j<operations; ++j){
+                v = v*31 + j;
+                doNotOptimize(v);
+            }
+            counter.executions.fetch_add(1, std::memory_order_relaxed);
+        };
+        //payloads can't be hashed, and are all equal, so they share a lane
+        if (scheme == ExecutorScheme::KEYED_STRAND) signal.connectKeyedSlot([](const P&){return (size_t)0;}, slot);
+        else signal.connectSlot(scheme, slot);
+    }
+    auto executed = [&counters, nSlots](){
+        uint64_t total = 0;
+        for (uint32_t i=0; i<nSlots; ++i) total += counters[i].executions.load(std::memory_order_relaxed);
+        return total;
+    };
+
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> emitters;
+    for (uint32_t e=0; e<nEmitters; ++e){
+        emitters.emplace_back([&, e](){
+            context.pinThread(e + 1);
+            P payload{};
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i=0; i<perEmitter; ++i){
+                signal.emitSignal(payload);
+            }
+        });
+    }
+    context.pinThread(0);
+    while (ready.load() < nEmitters) std::this_thread::yield();
+    context.beginMeasurement();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &t : emitters) t.join();
+    if (isDeferred(scheme)){
+        while (executed() < expected) signal.invokeDeferred();
+    }
+    while (executed() < expected) std::this_thread::yield();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    context.endMeasurement();
+
+    BenchmarkSample sample;
+    sample.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    sample.operations = perEmitter*nEmitters;
+    sample.metrics["ns_per_execution"] = (double)sample.nanoseconds/expected;
+    return sample;
+}
+
+template <typename P>
+void registerPayload(BenchmarkRegistry& registry, uint32_t size){
+    const ExecutorScheme schemes[] = {
+        ExecutorScheme::SYNCHRONOUS, ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED,
+        ExecutorScheme::ASYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::SINGLE_PRODUCER_STRAND,
+        ExecutorScheme::THREAD_POOLED, ExecutorScheme::KEYED_STRAND, ExecutorScheme::PARALLEL_SYNCHRONOUS
+    };
+    for (auto scheme : schemes){
+        for (uint32_t nSlots : {1u, 8u, 64u}){
+            for (uint32_t nEmitters : {1u, 4u}){
+                //single producer strands can't be emitted to concurrently
+                if (scheme == ExecutorScheme::SINGLE_PRODUCER_STRAND && nEmitters > 1) continue;
+                Benchmark benchmark;
+                benchmark.name = std::string("signal/") + getExecutorName(scheme) + "/slots:" + std::to_string(nSlots)
+                    + "/emitters:" + std::to_string(nEmitters) + "/payload:" + std::to_string(size);
+                benchmark.parameters = {
+                    {"executor", getExecutorName(scheme)},
+                    {"slots", std::to_string(nSlots)},
+                    {"emitters", std::to_string(nEmitters)},
+                    {"payload", std::to_string(size)}
+                };
+                benchmark.usesPersistentThreads = usesThreadPool(scheme);
+                benchmark.run = [scheme, nSlots, nEmitters](const BenchmarkContext& context){
+                    return runEmissions<P>(context, scheme, nSlots, nEmitters);
+                };
+                registry.add(std::move(benchmark));
+            }
+        }
+    }
+}
+
+//frames of emissions to a deferred slot, each drained by invokeDeferred;
+//an operation is one emission and its invocation
+BenchmarkSample runDeferredFrames(const BenchmarkContext& context, ExecutorScheme scheme, uint32_t frameSize){
+    const uint64_t nFrames = std::max<uint64_t>(1, context.scaled(executionBudget)/frameSize);
+    Signal<uint32_t> signal;
+    uint64_t sum = 0;
+    signal.connectSlot(scheme, [&sum](uint32_t x){
+        sum += x;
+    });
+    context.pinThread(0);
+    std::chrono::steady_clock::duration emitTime{0}, invokeTime{0};
+    context.beginMeasurement();
+    for (uint64_t f=0; f<nFrames; ++f){
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i=0; i<frameSize; ++i) signal.emitSignal(i);
+        auto emitted = std::chrono::steady_clock::now();
+        signal.invokeDeferred();
+        emitTime += emitted - start;
+        invokeTime += std::chrono::steady_clock::now() - emitted;
+    }
+    context.endMeasurement();
+    doNotOptimize(sum);
+
+    BenchmarkSample sample;
+    sample.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(emitTime + invokeTime).count();
+    sample.operations = nFrames*frameSize;
+    sample.metrics["emit_ns"] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(emitTime).count()/sample.operations;
+    sample.metrics["invoke_ns"] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(invokeTime).count()/sample.operations;
+    return sample;
+}
+
+void registerDeferredFrames(BenchmarkRegistry& registry){
+    const uint32_t frameSize = 10000;
+    for (auto scheme : {ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED}){
+        Benchmark benchmark;
+        benchmark.name = std::string("deferred/") + getExecutorName(scheme) + "/frame:" + std::to_string(frameSize);
+        benchmark.parameters = {
+            {"executor", getExecutorName(scheme)},
+            {"frame", std::to_string(frameSize)}
+        };
+        benchmark.run = [scheme, frameSize](const BenchmarkContext& context){
+            return runDeferredFrames(context, scheme, frameSize);
+        };
+        registry.add(std::move(benchmark));
+    }
+}
+
+//a single emitter to slots doing some work, where the emitter of a single
+//producer strand doesn't contend with the strand thread on a shared queue
+void registerSingleProducer(BenchmarkRegistry& registry){
+    for (auto scheme : {ExecutorScheme::STRAND, ExecutorScheme::SINGLE_PRODUCER_STRAND}){
+        for (uint32_t nSlots : {1u, 10u}){
+            for (uint32_t operations : {1u, 100u}){
+                Benchmark benchmark;
+                benchmark.name = std::string("single_producer/") + getExecutorName(scheme) + "/slots:" + std::to_string(nSlots)
+                    + "/operations:" + std::to_string(operations);
+                benchmark.parameters = {
+                    {"executor", getExecutorName(scheme)},
+                    {"slots", std::to_string(nSlots)},
+                    {"operations", std::to_string(operations)}
+                };
+                benchmark.run = [scheme, nSlots, operations](const BenchmarkContext& context){
+                    return runEmissions<uint32_t>(context, scheme, nSlots, 1, operations);
+                };
+                registry.add(std::move(benchmark));
+            }
+        }
+    }
+}
+
+//emissions to a large number of slots, each doing a little work, which
+//parallel synchronous emission splits across the thread pool
+BenchmarkSample runFanOut(const BenchmarkContext& context, ExecutorScheme scheme, uint32_t nSlots){
+    const uint64_t nEmissions = std::max<uint64_t>(1, context.scaled(executionBudget)/nSlots);
+    Signal<uint32_t> signal;
+    for (uint32_t i=0; i<nSlots; ++i){
+        signal.connectSlot(scheme, [i](uint32_t x){
+            uint64_t sum = 0;
+            for (uint32_t j=0; j<20; ++j) sum += (x ^ j) * i;
+            doNotOptimize(sum);
+        });
+    }
+    context.pinThread(0);
+    context.beginMeasurement();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t e=0; e<nEmissions; ++e){
+        signal.emitSignal((uint32_t)e);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    context.endMeasurement();
+
+    BenchmarkSample sample;
+    sample.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    sample.operations = nEmissions;
+    return sample;
+}
+
+//emissions to a single synchronous slot, so that the time is dominated by
+//the signal's instrumentation
+template <typename Policy>
+BenchmarkSample runInstrumentedEmissions(const BenchmarkContext& context, bool trace){
+    const uint64_t nEmissions = context.scaled(executionBudget);
+    BasicSignal<Policy, uint32_t> signal;
+    uint64_t sum = 0;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){
+        sum += x;
+    });
+    context.pinThread(0);
+    if (trace) BSignals::startTracing();
+    context.beginMeasurement();
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i=0; i<nEmissions; ++i){
+        signal.emitSignal((uint32_t)i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    context.endMeasurement();
+    if (trace) BSignals::stopTracing();
+    doNotOptimize(sum);
+
+    BenchmarkSample sample;
+    sample.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    sample.operations = nEmissions;
+    return sample;
+}
+
+void registerFanOut(BenchmarkRegistry& registry){
+    const uint32_t nSlots = 10000;
+    for (auto scheme : {ExecutorScheme::SYNCHRONOUS, ExecutorScheme::PARALLEL_SYNCHRONOUS}){
+        Benchmark benchmark;
+        benchmark.name = std::string("fanout/") + getExecutorName(scheme) + "/slots:" + std::to_string(nSlots);
+        benchmark.parameters = {
+            {"executor", getExecutorName(scheme)},
+            {"slots", std::to_string(nSlots)}
+        };
+        benchmark.usesPersistentThreads = usesThreadPool(scheme);
+        benchmark.run = [scheme, nSlots](const BenchmarkContext& context){
+            return runFanOut(context, scheme, nSlots);
+        };
+        registry.add(std::move(benchmark));
+    }
+}
+
+void registerInstrumentation(BenchmarkRegistry& registry){
+    auto add = [&registry](const char* policy, std::function<BenchmarkSample(const BenchmarkContext&)> run){
+        Benchmark benchmark;
+        benchmark.name = std::string("instrumentation/") + policy;
+        benchmark.parameters = {{"policy", policy}};
+        benchmark.run = std::move(run);
+        registry.add(std::move(benchmark));
+    };
+    add("none", [](const BenchmarkContext& context){
+        return runInstrumentedEmissions<NoInstrumentation>(context, false);
+    });
+    add("counting", [](const BenchmarkContext& context){
+        return runInstrumentedEmissions<CountingInstrumentation>(context, false);
+    });
+    add("timing", [](const BenchmarkContext& context){
+        return runInstrumentedEmissions<TimingInstrumentation>(context, false);
+    });
+    //tracing instrumentation costs a check per emission while tracing is stopped
+    add("tracing_stopped", [](const BenchmarkContext& context){
+        return runInstrumentedEmissions<TracingInstrumentation>(context, false);
+    });
+    add("tracing", [](const BenchmarkContext& context){
+        return runInstrumentedEmissions<TracingInstrumentation>(context, true);
+    });
+}
+
+}
+
+void registerSignalBenchmarks(BenchmarkRegistry& registry){
+    registerPayload<Payload<8>>(registry, 8);
+    registerPayload<Payload<64>>(registry, 64);
+    registerPayload<Payload<1024>>(registry, 1024);
+    registerDeferredFrames(registry);
+    registerSingleProducer(registry);
+    registerFanOut(registry);
+    registerInstrumentation(registry);
+}
@@ -0,0 +1,42 @@
+#include "TscClock.h"
+#include <fstream>
+#include <string>
+#include <thread>
+
+bool TscClock::useTsc = false;
+double TscClock::nanosecondsPerTick = 1.0;
+
+namespace{
+
+bool isTscInvariant(){
+#ifdef BSIGNALS_HAS_TSC
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)){
+        if (line.compare(0, 5, "flags") == 0){
+            return (line.find(" constant_tsc") != std::string::npos && line.find(" nonstop_tsc") != std::string::npos);
+        }
+    }
+#endif
+    return false;
+}
+
+}
+
+void TscClock::initialize() {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+    useTsc = isTscInvariant();
+    if (!useTsc) return;
+    auto steadyStart = std::chrono::steady_clock::now();
+    uint64_t tscStart = now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t tscEnd = now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - steadyStart).count();
+    if (tscEnd <= tscStart){
+        useTsc = false;
+        return;
+    }
+    nanosecondsPerTick = (double)elapsed/(tscEnd - tscStart);
+}
@@ -0,0 +1,52 @@
+/*
+ * File:   TscClock.h
+ * Author: Barath Kannan
+ * Low overhead timestamps from the time stamp counter, for latency
+ * measurements. The counter is only used where it is invariant (constant
+ * rate, and not stopped in idle states), so that timestamps taken on
+ * different cores are comparable; otherwise the steady clock is used.
+ * Ticks are converted to nanoseconds with a rate calibrated against the
+ * steady clock on first use.
+ * Created on 20 October 2026, 7:10 AM
+ */
+
+#ifndef BSIGNALS_TSCCLOCK_H
+#define BSIGNALS_TSCCLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BSIGNALS_HAS_TSC 1
+#endif
+
+class TscClock{
+public:
+    //calibrates the clock, called before the first measurement
+    static void initialize();
+
+    static uint64_t now(){
+#ifdef BSIGNALS_HAS_TSC
+        if (useTsc) return __rdtsc();
+#endif
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static uint64_t toNanoseconds(uint64_t ticks){
+        return (uint64_t)(ticks*nanosecondsPerTick);
+    }
+
+    static uint64_t fromNanoseconds(double nanoseconds){
+        return (uint64_t)(nanoseconds/nanosecondsPerTick);
+    }
+
+    static bool isTsc(){
+        return useTsc;
+    }
+
+private:
+    static bool useTsc;
+    static double nanosecondsPerTick;
+};
+
+#endif /* BSIGNALS_TSCCLOCK_H */
@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "TscClock.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+
+namespace{
+
+void printUsage(const char* program){
+    std::cout << "Usage: " << program << " [options]\n"
+        << "  --list               list the benchmarks and exit\n"
+        << "  --filter a,b         run benchmarks whose name contains any of the terms\n"
+        << "  --repetitions N      measured repetitions of each benchmark (default 5)\n"
+        << "  --warmup N           discarded repetitions before measuring (default 1)\n"
+        << "  --scale X            multiply the operations of each repetition (default 1)\n"
+        << "  --cpus 0,2,4         cpus to pin benchmark threads to (default every allowed cpu)\n"
+        << "  --no-pin             don't pin benchmark threads\n"
+        << "  --no-counters        don't collect performance counters\n"
+        << "  --json PATH          write the results as JSON\n"
+        << "  --compare PATH       flag regressions against a baseline written by --json\n"
+        << "  --current PATH       with --compare, compare these saved results instead of running\n"
+        << "  --threshold PCT      percentage slowdown reported as a regression (default 10)\n"
+        << "Exits with 1 if any benchmark regressed." << std::endl;
+}
+
+std::vector<uint32_t> parseCpus(const std::string& list){
+    std::vector<uint32_t> cpus;
+    std::stringstream ss(list);
+    std::string cpu;
+    while (std::getline(ss, cpu, ',')){
+        cpus.push_back((uint32_t)std::stoul(cpu));
+    }
+    if (cpus.empty()) throw std::invalid_argument("no cpus given");
+    return cpus;
+}
+
+}
+
+int main(int argc, char *argv[]){
+    BenchmarkOptions options;
+    bool list = false;
+    std::string jsonPath, baselinePath, currentPath;
+    double threshold = 10.0;
+    try{
+        for (int i=1; i<argc; ++i){
+            std::string arg = argv[i];
+            auto value = [&](){
+                if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+                return std::string(argv[++i]);
+            };
+            if (arg == "--list") list = true;
+            else if (arg == "--filter") options.filter = value();
+            else if (arg == "--repetitions") options.repetitions = (uint32_t)std::stoul(value());
+            else if (arg == "--warmup") options.warmup = (uint32_t)std::stoul(value());
+            else if (arg == "--scale") options.scale = std::stod(value());
+            else if (arg == "--cpus") options.cpus = parseCpus(value());
+            else if (arg == "--no-pin") options.pin = false;
+            else if (arg == "--no-counters") options.counters = false;
+            else if (arg == "--json") jsonPath = value();
+            else if (arg == "--compare") baselinePath = value();
+            else if (arg == "--current") currentPath = value();
+            else if (arg == "--threshold") threshold = std::stod(value());
+            else if (arg == "--help" || arg == "-h"){
+                printUsage(argv[0]);
+                return 0;
+            }
+            else throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    catch (const std::exception& e){
+        std::cerr << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    BenchmarkRegistry registry;
+    registerSignalBenchmarks(registry);
+    registerLatencyBenchmarks(registry);
+    registerPrimitiveBenchmarks(registry);
+
+    if (list){
+        for (auto const &name : registry.getNames(options.filter)) std::cout << name << std::endl;
+        return 0;
+    }
+
+    try{
+        std::map<std::string, double> current;
+        if (!currentPath.empty()){
+            if (baselinePath.empty()) throw std::invalid_argument("--current needs --compare");
+            current = readBaseline(currentPath);
+        }
+        else{
+            TscClock::initialize();
+            auto results = registry.run(options, std::cout);
+            if (!jsonPath.empty()){
+                std::ofstream file(jsonPath);
+                writeJson(results, options, file);
+                if (!file) throw std::runtime_error("unable to write " + jsonPath);
+            }
+            current = getMedians(results);
+        }
+        if (!baselinePath.empty()){
+            return (compareToBaseline(current, readBaseline(baselinePath), threshold, std::cout) > 0 ? 1 : 0);
+        }
+    }
+    catch (const std::exception& e){
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
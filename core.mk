@@ -13,6 +13,7 @@ FLAGSDIR = flags
 MOCDIR = moc
 ADDOBJDIR = addobj
 TESTOBJDIR = testobj
+BENCHOBJDIR = benchobj
 NMDIR = nm
 
 #>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -70,19 +71,23 @@ ifeq ($(MAKECMDGOALS),debug)
 BUILD_TYPE=debug
 else ifeq ($(MAKECMDGOALS),release)
 BUILD_TYPE=release
+else ifeq ($(MAKECMDGOALS),coroutines)
+BUILD_TYPE=coroutines
 endif
 
 ifeq ($(BUILD_TYPE),debug)
 EXTRAOPTS=$(DEBUG_OPTS)
 else ifeq ($(BUILD_TYPE),release)
 EXTRAOPTS=$(RELEASE_OPTS)
+else ifeq ($(BUILD_TYPE),coroutines)
+EXTRAOPTS=$(COROUTINE_OPTS)
 endif
 
 BUILDDIR=$(GENDIR)/$(BUILD_TYPE)
 
 # Files and folders
-MAINCODEDIRS=$(SRCDIR) $(INCDIR) $(TESTDIR)
-MAINGENDIRS=$(addprefix $(BUILDDIR)/, $(BINDIR) $(GENLIB)/static $(GENLIB)/dynamic $(FLAGSDIR) $(TESTDIR) $(ADDOBJDIR))
+MAINCODEDIRS=$(SRCDIR) $(INCDIR) $(TESTDIR) $(BENCHDIR)
+MAINGENDIRS=$(addprefix $(BUILDDIR)/, $(BINDIR) $(GENLIB)/static $(GENLIB)/dynamic $(FLAGSDIR) $(TESTDIR) $(BENCHDIR) $(ADDOBJDIR))
 
 SRCS = $(call filterext, $(SRCTYPES), $(SRCDIR))
 SRCDIRNAMES = $(call getdirectories, $(SRCS))
@@ -118,6 +123,11 @@ TESTINCDIRNAMES = $(call getdirectories, $(TESTINCS)) $(TESTINC)
 I_TESTINCDIRS = $(addprefix -I, $(TESTINCDIRNAMES))
 endif
 
+ifeq ($(BUILD_BENCHMARKS),1)
+BENCHSRCS = $(call filterext, $(SRCTYPES), $(BENCHDIR))
+I_BENCHINCDIRS = $(addprefix -I, $(BENCHDIR))
+endif
+
 ifeq ($(BUILD_MOCS),1)
 MOCSRCS = $(patsubst $(INCDIR)/%.h, $(BUILDDIR)/$(MOCDIR)/%.cpp, $(INCS))
 MOCOBJS = $(patsubst $(INCDIR)/%.h, $(BUILDDIR)/$(MOCDIR)/%.o, $(INCS))
@@ -139,6 +149,12 @@ TESTOBJDIRNAMES = $(call getdirectories, $(TESTOBJS))
 TESTDEPS = $(patsubst %.o, %.d, $(TESTOBJS))
 EXISTINGTESTDEPS = $(call filterext, d, $(BUILDDIR)/$(TESTOBJDIR))
 
+BENCHOBJS = $(patsubst $(BENCHDIR)/%,$(BUILDDIR)/$(BENCHOBJDIR)/%.o, $(call extractbasename, $(BENCHSRCS)))
+BENCHOBJDIRNAMES = $(call getdirectories, $(BENCHOBJS))
+
+BENCHDEPS = $(patsubst %.o, %.d, $(BENCHOBJS))
+EXISTINGBENCHDEPS = $(call filterext, d, $(BUILDDIR)/$(BENCHOBJDIR))
+
 ifeq ($(EXPLICIT_MAIN_SOURCE),)
 NMS = $(patsubst $(SRCDIR)/%,$(BUILDDIR)/$(NMDIR)/%.nm, $(call extractbasename, $(SRCS)))
 NMDIRNAMES = $(call getdirectories, $(NMS))
@@ -172,6 +188,9 @@ release: all
 .PHONY: debug
 debug: all
 
+.PHONY: coroutines
+coroutines: all
+
 .PHONY: all
 all:	$(BUILDDIR)/$(FLAGSDIR)/pre-build $(BUILDDIR)/$(FLAGSDIR)/$(PROJECT) $(BUILDDIR)/$(FLAGSDIR)/post-build
 
@@ -183,11 +202,11 @@ clean:
 
 ### !! MAIN TARGET TREE !! ###
 
-GENDIRS_CONSTRUCT = $(OBJDIRNAMES) $(MAINGENDIRS) $(MAINCODEDIRS) $(TESTOBJDIRNAMES) $(NMDIRNAMES) $(MOCSRCDIRNAMES)
+GENDIRS_CONSTRUCT = $(OBJDIRNAMES) $(MAINGENDIRS) $(MAINCODEDIRS) $(TESTOBJDIRNAMES) $(BENCHOBJDIRNAMES) $(NMDIRNAMES) $(MOCSRCDIRNAMES)
 $(BUILDDIR)/$(FLAGSDIR)/gendirs: | $(GENDIRS_CONSTRUCT)
 	@touch $@
 
-$(BUILDDIR)/$(FLAGSDIR)/pre-build: $(BUILDDIR)/$(FLAGSDIR)/gendirs $(SRCS) $(TESTSRCS)
+$(BUILDDIR)/$(FLAGSDIR)/pre-build: $(BUILDDIR)/$(FLAGSDIR)/gendirs $(SRCS) $(TESTSRCS) $(BENCHSRCS)
 	@echo "Building $(PROJECT) Project ($(VERSION))"
 ifeq ($(RUN_PREBUILD), 1)
 	@echo "Running pre-build steps"
@@ -196,7 +215,7 @@ ifeq ($(RUN_PREBUILD), 1)
 endif
 	@touch $@
 
-GENOBJS_CONSTRUCT = $(OBJS) $(MOCOBJS) $(MOCSRCS) $(ADDOBJS) $(TESTOBJS) $(DEPS) $(TESTDEPS) $(NMS) $(ADDOBJDEPS)
+GENOBJS_CONSTRUCT = $(OBJS) $(MOCOBJS) $(MOCSRCS) $(ADDOBJS) $(TESTOBJS) $(BENCHOBJS) $(DEPS) $(TESTDEPS) $(BENCHDEPS) $(NMS) $(ADDOBJDEPS)
 $(GENOBJS_CONSTRUCT) : | $(BUILDDIR)/$(FLAGSDIR)/pre-build 
 $(BUILDDIR)/$(FLAGSDIR)/genobjs: $(GENOBJS_CONSTRUCT) 
 ifeq ($(EXPLICIT_MAIN_SOURCE),)
@@ -262,8 +281,20 @@ endif
 
 $(BUILDDIR)/$(FLAGSDIR)/linktests: $(TEST_BINARY_CONSTRUCT) $(BUILDDIR)/$(FLAGSDIR)/genobjs | $(BUILDDIR)/$(FLAGSDIR)/pre-build
 	@touch $@
+
+ifeq ($(BUILD_BENCHMARKS), 1)
+BENCHMARK_BINARY_CONSTRUCT = $(BUILDDIR)/$(BENCHDIR)/$(PROJECT)Benchmark
+$(BENCHMARK_BINARY_CONSTRUCT) : $(BUILDDIR)/$(FLAGSDIR)/genobjs | $(BUILDDIR)/$(FLAGSDIR)/pre-build
+$(BUILDDIR)/$(BENCHDIR)/$(PROJECT)Benchmark :
+	@echo "Generating benchmarks:"
+	$(CC) $(OPTS) $(EXTRAOPTS) $(D_DEFINES) $(CFLAGS) $(CPPFLAGS) $(NOTMAINOBJFILES) $(MOCOBJS) $(ADDOBJS) $(BENCHOBJS) $(LINKS) $(L_LIBDIRS) $(l_LINKLIBS) -o $(BUILDDIR)/$(BENCHDIR)/$(PROJECT)Benchmark
+	@echo "Benchmarks generated"
+endif
+
+$(BUILDDIR)/$(FLAGSDIR)/linkbenchmarks: $(BENCHMARK_BINARY_CONSTRUCT) $(BUILDDIR)/$(FLAGSDIR)/genobjs | $(BUILDDIR)/$(FLAGSDIR)/pre-build
+	@touch $@
 	
-$(BUILDDIR)/$(FLAGSDIR)/$(PROJECT): $(BUILDDIR)/$(FLAGSDIR)/linklibsdynamic $(BUILDDIR)/$(FLAGSDIR)/linklibsstatic $(BUILDDIR)/$(FLAGSDIR)/linkbins $(BUILDDIR)/$(FLAGSDIR)/linktests | $(BUILDDIR)/$(FLAGSDIR)/pre-build
+$(BUILDDIR)/$(FLAGSDIR)/$(PROJECT): $(BUILDDIR)/$(FLAGSDIR)/linklibsdynamic $(BUILDDIR)/$(FLAGSDIR)/linklibsstatic $(BUILDDIR)/$(FLAGSDIR)/linkbins $(BUILDDIR)/$(FLAGSDIR)/linktests $(BUILDDIR)/$(FLAGSDIR)/linkbenchmarks | $(BUILDDIR)/$(FLAGSDIR)/pre-build
 	@touch $@
 	
 $(BUILDDIR)/$(FLAGSDIR)/post-build: $(BUILDDIR)/$(FLAGSDIR)/$(PROJECT) $(BUILDDIR)/$(FLAGSDIR)/linklibsstatic $(BUILDDIR)/$(FLAGSDIR)/linklibsdynamic $(BUILDDIR)/$(FLAGSDIR)/genobjs $(BUILDDIR)/$(FLAGSDIR)/pre-build $(BUILDDIR)/$(FLAGSDIR)/gendirs
@@ -287,6 +318,7 @@ $(foreach GENDIR, $(MAINGENDIRS), $(eval $(call directory_rule,$(GENDIR))))
 $(foreach OBJDIR, $(OBJDIRNAMES), $(eval $(call directory_rule,$(OBJDIR))))
 $(foreach NMDIR, $(NMDIRNAMES), $(eval $(call directory_rule,$(NMDIR))))
 $(foreach TOBJDIR_F, $(TESTOBJDIRNAMES), $(eval $(call directory_rule,$(TOBJDIR_F))))
+$(foreach BOBJDIR_F, $(BENCHOBJDIRNAMES), $(eval $(call directory_rule,$(BOBJDIR_F))))
 $(foreach MOCSRCDIR_F, $(MOCSRCDIRNAMES), $(eval $(call directory_rule, $(MOCSRCDIR_F))))
 
 #Defines the compilation rule 
@@ -302,6 +334,12 @@ $(BUILDDIR)/$(TESTOBJDIR)/%.o : $(TESTDIR)/%.$1
 	@echo "Compiling $$<"
 	$(CC) $(OPTS) $(EXTRAOPTS) $(D_DEFINES) $(CFLAGS) $(CPPFLAGS) $(I_INCDIRS) $(I_TESTINCDIRS) $(I_EXTINCDIRS) -MP -MMD -c $$< -o $$@
 	@echo "Completed compilation of $$<"
+
+$(BUILDDIR)/$(BENCHOBJDIR)/%.d : $(BUILDDIR)/$(BENCHOBJDIR)/%.o
+$(BUILDDIR)/$(BENCHOBJDIR)/%.o : $(BENCHDIR)/%.$1 
+	@echo "Compiling $$<"
+	$(CC) $(OPTS) $(EXTRAOPTS) $(D_DEFINES) $(CFLAGS) $(CPPFLAGS) $(I_INCDIRS) $(I_BENCHINCDIRS) $(I_EXTINCDIRS) -MP -MMD -c $$< -o $$@
+	@echo "Completed compilation of $$<"
 endef
 $(foreach SRCTYPE, $(SRCTYPES), $(eval $(call compile_rule,$(SRCTYPE))))
 
@@ -316,6 +354,7 @@ $(foreach ASRC, $(ADDSRC),$(eval $(call compile_rule_addobjs,$(ASRC))))
 
 $(eval include $(EXISTINGDEPS))
 $(eval include $(EXISTINGTESTDEPS))
+$(eval include $(EXISTINGBENCHDEPS))
 $(eval include $(EXISTINGADDOBJDEPS))
 
 $(BUILDDIR)/$(NMDIR)/%.nm : | $(BUILDDIR)/$(OBJDIR)/%.o
@@ -0,0 +1,55 @@
+/*
+ * File:   CompletionHandle.h
+ * Author: Barath Kannan
+ * Returned by Signal::emitAsync, to find out when every slot has finished
+ * processing the emission. The handle is move only, and backed by a pooled
+ * countdown latch (so it doesn't allocate in the common case).
+ * Created on 19 October 2026, 8:45 PM
+ */
+
+#ifndef BSIGNALS_COMPLETIONHANDLE_H
+#define BSIGNALS_COMPLETIONHANDLE_H
+
+#include <functional>
+#include <chrono>
+#include "BSignals/details/CompletionState.h"
+
+namespace BSignals{
+
+class CompletionHandle{
+public:
+    //an empty handle is always complete
+    CompletionHandle() = default;
+    explicit CompletionHandle(details::CompletionState* s);
+    CompletionHandle(CompletionHandle&& that) noexcept;
+    CompletionHandle& operator=(CompletionHandle&& that) noexcept;
+    ~CompletionHandle();
+
+    //true once every slot has processed (or discarded) the emission
+    bool isComplete() const;
+
+    //blocks until complete
+    void wait();
+
+    //blocks until complete or timeout has elapsed, returns isComplete()
+    template <typename Rep, typename Period>
+    bool waitFor(std::chrono::duration<Rep, Period> timeout){
+        if (!state) return true;
+        return state->waitFor(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout));
+    }
+
+    //continuation is invoked once complete, either immediately (if already
+    //complete) or on the thread which completes the last slot
+    //only one continuation can be registered per emission
+    void then(std::function<void()> continuation);
+
+private:
+    CompletionHandle(const CompletionHandle&) = delete;
+    void operator=(const CompletionHandle&) = delete;
+
+    details::CompletionState* state{nullptr};
+};
+
+}
+
+#endif /* BSIGNALS_COMPLETIONHANDLE_H */
@@ -0,0 +1,156 @@
+/*
+ * File:   EmissionRecorder.hpp
+ * Author: Barath Kannan
+ * Records every emission of a signal, with a timestamp, to an append only
+ * trace file mapped into memory. Each recording thread fills its own chunk
+ * of the file, so recording an emission is a clock read and a store into
+ * mapped memory, with an atomic increment only once per chunk of records.
+ * Traces are re-emitted by EmissionReplayer.
+ * Args must be trivially copyable.
+ * Created on 20 October 2026, 3:50 AM
+ */
+
+#ifndef BSIGNALS_EMISSIONRECORDER_HPP
+#define BSIGNALS_EMISSIONRECORDER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "BSignals/Signal.hpp"
+#include "BSignals/details/MappedFile.h"
+#include "BSignals/details/EmissionLog.hpp"
+
+namespace BSignals{
+
+template <typename... Args>
+class EmissionRecorder{
+public:
+    static_assert(details::AllTriviallyCopyable<Args...>::value, "recorded signal arguments must be trivially copyable");
+
+    //starts recording the emissions of signal to a new file at path (which
+    //is replaced if it exists), recording at most maxBytes (the file is
+    //sparse, and truncated to the length used once recording stops)
+    //timestamps are taken when the recorder's slot executes, so connect the
+    //recorder before any other slots for them to reflect emission time
+    //the signal must outlive the recorder
+    //throws std::system_error if the file can't be created
+    EmissionRecorder(Signal<Args...>& s, const std::string& path, size_t maxBytes = 256*1024*1024)
+    : signal(s), state(std::make_shared<State>(path, maxBytes)){
+        std::shared_ptr<State> recording = state;
+        slotId = signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [recording](Args... p){
+            recording->record(p...);
+        });
+    }
+
+    //stops recording, the file is complete once the signal has released
+    //the recorder's slot
+    ~EmissionRecorder(){
+        signal.disconnectSlot(slotId);
+    }
+
+    //emissions which didn't fit in maxBytes
+    uint64_t getDroppedCount() const{
+        return state->header->dropped.load(std::memory_order_relaxed);
+    }
+
+    //writes the records so far back to the file, blocking until done
+    void flush(){
+        state->file.sync();
+    }
+
+private:
+    typedef details::EmissionLog<Args...> Log;
+
+    EmissionRecorder(const EmissionRecorder&) = delete;
+    void operator=(const EmissionRecorder&) = delete;
+
+    //held by the slot as well, so it lives as long as emissions can reach it
+    struct State : public std::enable_shared_from_this<State>{
+        State(const std::string& path, size_t maxBytes)
+        : file(path, std::max(maxBytes, sizeof(typename Log::Header) + Log::getChunkSize())),
+          id(nextRecorderId().fetch_add(1, std::memory_order_relaxed)),
+          start(std::chrono::steady_clock::now()){
+            header = new (file.getData()) typename Log::Header;
+            header->magic = Log::logMagic;
+            header->signature = Log::getSignature();
+            header->recordSize = sizeof(typename Log::Record);
+            header->chunkRecords = Log::chunkRecords;
+            header->maxChunks = (file.getSize() - sizeof(typename Log::Header))/Log::getChunkSize();
+            header->nChunks.store(0, std::memory_order_relaxed);
+            header->dropped.store(0, std::memory_order_relaxed);
+        }
+
+        ~State(){
+            uint64_t nChunks = std::min(header->nChunks.load(), header->maxChunks);
+            file.setLength(sizeof(typename Log::Header) + nChunks*Log::getChunkSize());
+        }
+
+        void record(const Args& ... p){
+            uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            Cursor& cursor = getCursor();
+            if (cursor.used == Log::chunkRecords && !claimChunk(cursor)){
+                header->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            new (Log::getRecords(cursor.chunk) + cursor.used) typename Log::Record{timestamp, details::TrivialEmission<Args...>(p...)};
+            cursor.chunk->count.store(++cursor.used, std::memory_order_release);
+        }
+
+        //the chunk a thread is filling for one recorder
+        struct Cursor{
+            uint64_t recorder;
+            std::weak_ptr<State> state;
+            typename Log::Chunk* chunk;
+            uint32_t used;
+            uint32_t thread;
+        };
+
+        Cursor& getCursor(){
+            static thread_local std::vector<Cursor> cursors;
+            for (auto &cursor : cursors){
+                if (cursor.recorder == id) return cursor;
+            }
+            //first emission recorded by this thread, so forget any finished recorders
+            cursors.erase(std::remove_if(cursors.begin(), cursors.end(),
+                [](const Cursor& c){return c.state.expired();}), cursors.end());
+            cursors.push_back(Cursor{id, this->shared_from_this(), nullptr, Log::chunkRecords, nThreads++});
+            return cursors.back();
+        }
+
+        bool claimChunk(Cursor& cursor){
+            if (full.load(std::memory_order_relaxed)) return false;
+            uint64_t index = header->nChunks.fetch_add(1, std::memory_order_relaxed);
+            if (index >= header->maxChunks){
+                full.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            cursor.chunk = Log::getChunk(header, index);
+            cursor.chunk->thread = cursor.thread;
+            cursor.used = 0;
+            return true;
+        }
+
+        static std::atomic<uint64_t>& nextRecorderId(){
+            static std::atomic<uint64_t> next{0};
+            return next;
+        }
+
+        details::MappedFile file;
+        typename Log::Header* header;
+        const uint64_t id;
+        const std::chrono::steady_clock::time_point start;
+        std::atomic<uint32_t> nThreads{0};
+        std::atomic<bool> full{false};
+    };
+
+    Signal<Args...>& signal;
+    std::shared_ptr<State> state;
+    int slotId;
+};
+
+}
+
+#endif /* BSIGNALS_EMISSIONRECORDER_HPP */
@@ -0,0 +1,123 @@
+/*
+ * File:   EmissionReplayer.hpp
+ * Author: Barath Kannan
+ * Re-emits a trace written by EmissionRecorder, in timestamp order, at the
+ * original pace, scaled, or as fast as possible. Replaying a production
+ * trace against the same slots gives a benchmark with realistic arrival
+ * patterns, and the lateness reported shows whether the slots kept up.
+ * Created on 20 October 2026, 4:10 AM
+ */
+
+#ifndef BSIGNALS_EMISSIONREPLAYER_HPP
+#define BSIGNALS_EMISSIONREPLAYER_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include "BSignals/details/MappedFile.h"
+#include "BSignals/details/EmissionLog.hpp"
+
+namespace BSignals{
+
+template <typename... Args>
+class EmissionReplayer{
+public:
+    static_assert(details::AllTriviallyCopyable<Args...>::value, "recorded signal arguments must be trivially copyable");
+
+    struct Statistics{
+        uint64_t emissions{0};
+        std::chrono::nanoseconds elapsed{0};
+        //latest any emission started relative to its (scaled) recorded time
+        std::chrono::nanoseconds maxLateness{0};
+    };
+
+    //loads the trace at path
+    //throws std::system_error if it can't be read, or std::invalid_argument
+    //if it isn't a trace recorded with the same Args
+    explicit EmissionReplayer(const std::string& path)
+    : file(path){
+        auto header = static_cast<const typename Log::Header*>(file.getData());
+        if (file.getSize() < sizeof(typename Log::Header) || header->magic != Log::logMagic){
+            throw std::invalid_argument("EmissionReplayer: " + path + " is not an emission trace");
+        }
+        if (header->signature != Log::getSignature() || header->recordSize != sizeof(typename Log::Record) ||
+                header->chunkRecords != Log::chunkRecords){
+            throw std::invalid_argument("EmissionReplayer: " + path + " was recorded with different arguments");
+        }
+        dropped = header->dropped.load();
+        //the file may have been truncated while the recorder was still open
+        uint64_t nChunks = std::min(header->nChunks.load(), header->maxChunks);
+        nChunks = std::min<uint64_t>(nChunks, (file.getSize() - sizeof(typename Log::Header))/Log::getChunkSize());
+        for (uint64_t c=0; c<nChunks; ++c){
+            auto chunk = Log::getChunk(const_cast<typename Log::Header*>(header), c);
+            uint32_t count = std::min(chunk->count.load(std::memory_order_acquire), Log::chunkRecords);
+            auto chunkRecords = Log::getRecords(chunk);
+            for (uint32_t i=0; i<count; ++i){
+                records.push_back(&chunkRecords[i]);
+            }
+        }
+        //chunks are each in order already, but interleave with other threads'
+        std::stable_sort(records.begin(), records.end(),
+            [](const typename Log::Record* a, const typename Log::Record* b){return a->timestamp < b->timestamp;});
+    }
+
+    uint64_t getEmissionCount() const{
+        return records.size();
+    }
+
+    //time between the first and last recorded emissions
+    std::chrono::nanoseconds getDuration() const{
+        if (records.empty()) return std::chrono::nanoseconds(0);
+        return std::chrono::nanoseconds(records.back()->timestamp - records.front()->timestamp);
+    }
+
+    //emissions the recorder had no room for
+    uint64_t getDroppedCount() const{
+        return dropped;
+    }
+
+    //calls emit (a Signal, or any callable taking Args) with each recorded
+    //emission, blocking until the trace is finished
+    //speed scales the recorded pace (2.0 is twice as fast), or 0 replays
+    //without any waiting
+    template <typename F>
+    Statistics replay(F&& emit, double speed = 1.0) const{
+        Statistics statistics;
+        auto begin = std::chrono::steady_clock::now();
+        for (auto record : records){
+            if (speed > 0){
+                auto due = begin + std::chrono::nanoseconds((uint64_t)((record->timestamp - records.front()->timestamp)/speed));
+                auto now = std::chrono::steady_clock::now();
+                //sleep through long gaps, and yield through the end of them
+                if (due - now > std::chrono::microseconds(200)){
+                    std::this_thread::sleep_for(due - now - std::chrono::microseconds(100));
+                }
+                while ((now = std::chrono::steady_clock::now()) < due){
+                    std::this_thread::yield();
+                }
+                statistics.maxLateness = std::max(statistics.maxLateness, std::chrono::duration_cast<std::chrono::nanoseconds>(now - due));
+            }
+            record->emission.apply(emit);
+            ++statistics.emissions;
+        }
+        statistics.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+        return statistics;
+    }
+
+private:
+    typedef details::EmissionLog<Args...> Log;
+
+    EmissionReplayer(const EmissionReplayer&) = delete;
+    void operator=(const EmissionReplayer&) = delete;
+
+    details::MappedFile file;
+    std::vector<const typename Log::Record*> records;
+    uint64_t dropped{0};
+};
+
+}
+
+#endif /* BSIGNALS_EMISSIONREPLAYER_HPP */
@@ -0,0 +1,64 @@
+/*
+ * File:   EventLoop.h
+ * Author: Barath Kannan
+ * A deferred dispatch target which can be shared by any number of signals.
+ * Slots connected to an event loop are invoked when the owner of the loop
+ * calls runPending, in the order that they were emitted (across all signals).
+ * On Linux the loop exposes an eventfd which becomes readable when work is
+ * posted, so the owner can sleep in epoll/poll/select rather than polling.
+ * Created on 19 October 2026, 5:05 PM
+ */
+
+#ifndef BSIGNALS_EVENTLOOP_H
+#define BSIGNALS_EVENTLOOP_H
+
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace BSignals{
+
+class EventLoop{
+public:
+    EventLoop();
+    ~EventLoop();
+
+    //queue a task to be run on a subsequent call to runPending
+    //can be called concurrently from any number of threads
+    void post(std::function<void()> task);
+
+    //run every task that was posted before this call, in the order that
+    //they were posted. Tasks posted while running are left for the next call
+    //tasks must not throw
+    //returns the number of tasks run
+    uint32_t runPending();
+
+    //true if there are tasks waiting for runPending
+    bool hasPending() const;
+
+    //file descriptor which is readable while there are pending tasks
+    //(the readiness is cleared by runPending)
+    //returns -1 if eventfd is not supported on this platform
+    int getEventFd() const;
+
+private:
+    EventLoop(const EventLoop& that) = delete;
+    void operator=(const EventLoop&) = delete;
+
+    void signalEventFd();
+    void clearEventFd();
+
+    mutable std::mutex postLock;
+    std::vector<std::function<void()>> pending;
+
+    //held while running, the running buffer retains its capacity
+    std::mutex runLock;
+    std::vector<std::function<void()>> running;
+
+    int eventFd{-1};
+};
+
+}
+
+#endif /* BSIGNALS_EVENTLOOP_H */
@@ -36,6 +36,27 @@ namespace BSignals{
     // unperformant, and/or connected functions need to be processed in order 
     // of arrival (FIFO).
 
+    // PARALLEL SYNCHRONOUS:
+    // Emission occurs synchronously, but the parallel synchronous slots of a
+    // signal are split into chunks of 64, which are executed by the emitting
+    // thread and by helper tasks on the thread pool (up to one per additional
+    // hardware thread). When emit returns, all connected slots have been
+    // invoked and returned. They are executed after any other synchronous
+    // slots of the signal, in no particular order relative to each other.
+    // This method is recommended for large numbers of short, independent
+    // slots on one signal, where executing them serially would make emission
+    // latency linear in the number of slots.
+
+    // SINGLE PRODUCER STRAND:
+    // As for STRAND, but emitted parameters are enqueued on a wait-free
+    // single producer single consumer ring buffer instead of the multi
+    // producer queue. Emission to the slot must only ever occur from one
+    // thread (asserted in debug builds). If the ring is full, emissions are
+    // queued on an unbounded overflow list instead, so emission never waits
+    // for the strand thread.
+    // This method is recommended over STRAND when there is exactly one 
+    // emitting thread.
+
     // THREAD POOLED:
     // Emission occurs asynchronously. 
     // On connection, if it is the first thread pooled function by any signal, 
@@ -53,6 +74,27 @@ namespace BSignals{
     
     // DEFERRED_SYNCHRONOUS:
     // Emissions are queued up to be manually invoked through the invokeDeferred function
+
+    // DEFERRED_BUFFERED:
+    // As for DEFERRED_SYNCHRONOUS, but emitted parameters are stored by value
+    // in contiguous per-producer buffers owned by the slot, rather than being
+    // bound into a function object on a shared queue. invokeDeferred swaps the
+    // buffers out and iterates them, so there is no allocation per emission
+    // once the buffers have grown. Emissions from a single thread are invoked
+    // in order, but there is no ordering between threads or between slots.
+    // This method is recommended over DEFERRED_SYNCHRONOUS for frequent
+    // emissions that are drained once per frame/loop iteration.
+
+    // KEYED STRAND:
+    // Emission occurs asynchronously. A key is hashed from the emitted
+    // parameters (the first parameter with std::hash by default, or a key
+    // function given to connectKeyedSlot, which is required if the first
+    // parameter can't be hashed with std::hash) to one of 16 serial lanes
+    // owned by the slot. A lane with queued emissions is drained by one thread pool
+    // task at a time, so emissions with the same key are processed in order
+    // of arrival (FIFO) while different lanes are processed in parallel.
+    // This method is recommended when ordering only matters per key (e.g. per
+    // account or session), and a single STRAND thread would be a bottleneck.
 //
     
 enum class ExecutorScheme {
@@ -60,7 +102,11 @@ enum class ExecutorScheme {
     DEFERRED_SYNCHRONOUS,
     ASYNCHRONOUS,
     STRAND,
-    THREAD_POOLED
+    THREAD_POOLED,
+    SINGLE_PRODUCER_STRAND,
+    DEFERRED_BUFFERED,
+    KEYED_STRAND,
+    PARALLEL_SYNCHRONOUS
 };
 
 }
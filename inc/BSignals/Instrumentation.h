@@ -0,0 +1,170 @@
+/*
+ * File:   Instrumentation.h
+ * Author: Barath Kannan
+ * Instrumentation policies for BasicSignal. A policy is a class with the
+ * hooks below, which are called inline on every emission, so a policy whose
+ * hooks are empty (NoInstrumentation, the policy of Signal) compiles away
+ * entirely. begin hooks return a context (an empty struct for no-op hooks)
+ * which is passed to the matching end hook, and may be called concurrently
+ * from every emitting thread.
+ *
+ *     Context beginEmit();                             //emission begins
+ *     void endEmit(const Context&);                    //every slot has been dispatched
+ *     Context beginDispatch(uint32_t slotId);          //slot is executed, or its emission queued
+ *     void endDispatch(uint32_t slotId, const Context&);
+ *
+ * A policy may also declare static const bool tracesSlots = true, to have the
+ * signal construct the instrumented variants of its queued slots, which
+ * record trace events (see BSignals/Tracing.h).
+ *
+ * Created on 20 October 2026, 5:50 AM
+ */
+
+#ifndef BSIGNALS_INSTRUMENTATION_H
+#define BSIGNALS_INSTRUMENTATION_H
+
+#include <cstdint>
+#include <type_traits>
+#include "BSignals/Metrics.h"
+#include "BSignals/details/LatencyHistogram.h"
+#include "BSignals/details/Tracer.h"
+
+namespace BSignals{
+
+struct NoInstrumentation{
+    struct Context{};
+
+    Context beginEmit(){
+        return Context();
+    }
+
+    void endEmit(const Context&){}
+
+    Context beginDispatch(uint32_t){
+        return Context();
+    }
+
+    void endDispatch(uint32_t, const Context&){}
+};
+
+//counts emissions and dispatches
+class CountingInstrumentation{
+public:
+    struct Context{};
+
+    Context beginEmit(){
+        emissions.increment();
+        return Context();
+    }
+
+    void endEmit(const Context&){}
+
+    Context beginDispatch(uint32_t){
+        dispatches.increment();
+        return Context();
+    }
+
+    void endDispatch(uint32_t, const Context&){}
+
+    uint64_t getEmissionCount() const{
+        return emissions.load();
+    }
+
+    uint64_t getDispatchCount() const{
+        return dispatches.load();
+    }
+
+private:
+    details::ShardedCounter emissions;
+    details::ShardedCounter dispatches;
+};
+
+//records how long emissions take, and how long each dispatch to a slot
+//takes (the slot's execution time, for synchronous slots), in nanoseconds
+class TimingInstrumentation{
+public:
+    typedef uint64_t Context;
+
+    Context beginEmit(){
+        return details::getMetricsTimestamp();
+    }
+
+    void endEmit(Context start){
+        emitTime.record(details::getMetricsTimestamp() - start);
+    }
+
+    Context beginDispatch(uint32_t){
+        return details::getMetricsTimestamp();
+    }
+
+    void endDispatch(uint32_t, Context start){
+        dispatchTime.record(details::getMetricsTimestamp() - start);
+    }
+
+    HistogramSnapshot getEmitTime() const{
+        return emitTime.snapshot();
+    }
+
+    HistogramSnapshot getDispatchTime() const{
+        return dispatchTime.snapshot();
+    }
+
+private:
+    details::LatencyHistogram emitTime;
+    details::LatencyHistogram dispatchTime;
+};
+
+//records trace events for emissions made while tracing is started (see
+//BSignals/Tracing.h), including the handoff of emissions to STRAND,
+//SINGLE_PRODUCER_STRAND, KEYED_STRAND and THREAD_POOLED slots
+class TracingInstrumentation{
+public:
+    static const bool tracesSlots = true;
+
+    struct Context{
+        uint64_t emission;
+        //emission being dispatched when this one began (a synchronous slot
+        //may emit another traced signal)
+        uint64_t outer;
+    };
+
+    Context beginEmit(){
+        if (!details::Tracer::isEnabled()) return Context{0, 0};
+        Context context{details::Tracer::nextEmissionId(), details::Tracer::getCurrentEmission()};
+        details::Tracer::record(details::TraceEventType::EMIT_BEGIN, context.emission, 0);
+        details::Tracer::setCurrentEmission(context.emission);
+        return context;
+    }
+
+    void endEmit(const Context& context){
+        if (!context.emission) return;
+        details::Tracer::record(details::TraceEventType::EMIT_END, context.emission, 0);
+        details::Tracer::setCurrentEmission(context.outer);
+    }
+
+    uint64_t beginDispatch(uint32_t slotId){
+        uint64_t emission = details::Tracer::getCurrentEmission();
+        if (emission) details::Tracer::record(details::TraceEventType::DISPATCH_BEGIN, emission, slotId);
+        return emission;
+    }
+
+    void endDispatch(uint32_t slotId, uint64_t emission){
+        if (emission) details::Tracer::record(details::TraceEventType::DISPATCH_END, emission, slotId);
+    }
+};
+
+namespace details{
+
+//true if the policy declares tracesSlots = true
+template <typename Policy, typename = void>
+struct TracesSlots : std::false_type{};
+
+template <typename Policy>
+struct TracesSlots<Policy, decltype((void)Policy::tracesSlots)>
+: std::integral_constant<bool, Policy::tracesSlots>{};
+
+}
+
+}
+
+#endif /* BSIGNALS_INSTRUMENTATION_H */
@@ -0,0 +1,223 @@
+/*
+ * File:   KeyedSignal.hpp
+ * Author: Barath Kannan
+ * Signal whose slots subscribe to a key (or a range of keys, or a key
+ * predicate), and whose emissions carry a key. An emission only executes
+ * the slots subscribed to its key, found through a hash index, rather than
+ * every slot. Range and predicate subscriptions are evaluated once per
+ * distinct key, on the first emission of that key, and the resulting route
+ * of slots is memoized until the subscriptions change (the cache is cleared
+ * once it holds maxRoutes keys).
+ * Key must be hashable (std::hash) and ordered (operator<).
+ * Slots are executed from a copy of the route, without the route lock held,
+ * so (with thread safety enabled) they can emit, connect and disconnect on the
+ * same signal.
+ * Created on 20 October 2026, 12:20 AM
+ */
+
+#ifndef BSIGNALS_KEYEDSIGNAL_HPP
+#define BSIGNALS_KEYEDSIGNAL_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "BSignals/details/SignalImpl.hpp"
+#include "BSignals/details/SharedMutex.h"
+
+namespace BSignals{
+
+template <typename Key, typename... Args>
+class KeyedSignal{
+public:
+    KeyedSignal() = default;
+
+    KeyedSignal(bool enforceThreadSafety)
+    : signalImpl(enforceThreadSafety){}
+
+    //slot is executed for emissions of key
+    int connectSlot(ExecutorScheme scheme, const Key& key, std::function<void(Args...)> slot){
+        //the slot is connected before the route lock is taken, as emissions
+        //lock the slots first
+        uint32_t id = signalImpl.connectSlot(scheme, slot);
+        routeLock.lock();
+        exact[key].push_back(id);
+        //the slot may not be connected until the next emission, which
+        //resolves the route again
+        routes.erase(key);
+        ++generation;
+        routeLock.unlock();
+        return (int)id;
+    }
+
+    //slot is executed for emissions of any key in [low, high]
+    int connectRangeSlot(ExecutorScheme scheme, const Key& low, const Key& high, std::function<void(Args...)> slot){
+        uint32_t id = signalImpl.connectSlot(scheme, slot);
+        routeLock.lock();
+        ranges.push_back(RangeSubscription{low, high, id});
+        routes.clear();
+        ++generation;
+        routeLock.unlock();
+        return (int)id;
+    }
+
+    //slot is executed for emissions of any key for which predicate is true
+    //the predicate is evaluated once per key, and must always give the same result
+    int connectPredicateSlot(ExecutorScheme scheme, std::function<bool(const Key&)> predicate, std::function<void(Args...)> slot){
+        uint32_t id = signalImpl.connectSlot(scheme, slot);
+        routeLock.lock();
+        predicates.push_back(PredicateSubscription{std::move(predicate), id});
+        routes.clear();
+        ++generation;
+        routeLock.unlock();
+        return (int)id;
+    }
+
+    void disconnectSlot(int id){
+        routeLock.lock();
+        for (auto it = exact.begin(); it != exact.end();){
+            it->second.erase(std::remove(it->second.begin(), it->second.end(), (uint32_t)id), it->second.end());
+            if (it->second.empty()) it = exact.erase(it);
+            else ++it;
+        }
+        ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+            [id](const RangeSubscription& r){return r.id == (uint32_t)id;}), ranges.end());
+        predicates.erase(std::remove_if(predicates.begin(), predicates.end(),
+            [id](const PredicateSubscription& p){return p.id == (uint32_t)id;}), predicates.end());
+        routes.clear();
+        ++generation;
+        routeLock.unlock();
+        signalImpl.disconnectSlot(id);
+    }
+
+    void emitKeyed(const Key& key, const Args& ... p){
+        //slots can't be removed while they're locked, so a route holds the
+        //slots themselves, and is copied without a reference count or a
+        //lookup per slot. The route lock is taken in either mode, since
+        //concurrent emissions of new keys both insert into the route cache
+        signalImpl.lockSlots();
+        RouteCopy route;
+        routeLock.lock_shared();
+        auto it = routes.find(key);
+        if (it != routes.end()){
+            route.assign(it->second);
+            routeLock.unlock_shared();
+        }
+        else{
+            //first emission of this key since the subscriptions changed
+            std::vector<uint32_t> ids = compileRoute(key);
+            uint64_t compiledGeneration = generation;
+            routeLock.unlock_shared();
+            Route resolved;
+            resolved.reserve(ids.size());
+            bool complete = true;
+            for (auto id : ids){
+                auto slot = signalImpl.resolveSlot(id);
+                if (slot) resolved.emplace_back(id, slot);
+                else complete = false;
+            }
+            route.assign(resolved);
+            routeLock.lock();
+            //a route compiled before the subscriptions changed, or before all
+            //of its slots were connected, is still used for this emission,
+            //but isn't memoized
+            if (complete && generation == compiledGeneration){
+                //bounded, since emissions can carry arbitrarily many keys
+                if (routes.size() >= maxRoutes) routes.clear();
+                routes.emplace(key, std::move(resolved));
+            }
+            routeLock.unlock();
+        }
+        signalImpl.emitSignalTo(route.begin(), route.end(), p...);
+        signalImpl.unlockSlots();
+    }
+
+    void invokeDeferred(){
+        signalImpl.invokeDeferred();
+    }
+
+private:
+    KeyedSignal(const KeyedSignal&) = delete;
+    void operator=(const KeyedSignal&) = delete;
+
+    struct RangeSubscription{
+        Key low;
+        Key high;
+        uint32_t id;
+    };
+
+    struct PredicateSubscription{
+        std::function<bool(const Key&)> predicate;
+        uint32_t id;
+    };
+
+    typedef typename details::SignalImpl<Args...>::ResolvedSlot ResolvedSlot;
+    typedef std::vector<ResolvedSlot> Route;
+
+    //a route copied for one emission, on the stack unless it's long
+    class RouteCopy{
+    public:
+        void assign(const Route& route){
+            if (route.size() <= inlineSlots){
+                std::copy(route.begin(), route.end(), inlineRoute.begin());
+                first = inlineRoute.data();
+                last = first + route.size();
+            }
+            else{
+                overflow = route;
+                first = overflow.data();
+                last = first + overflow.size();
+            }
+        }
+
+        const ResolvedSlot* begin() const{
+            return first;
+        }
+
+        const ResolvedSlot* end() const{
+            return last;
+        }
+
+    private:
+        static const size_t inlineSlots{8};
+        std::array<ResolvedSlot, inlineSlots> inlineRoute;
+        Route overflow;
+        const ResolvedSlot* first{nullptr};
+        const ResolvedSlot* last{nullptr};
+    };
+
+    //routeLock must be held (shared is sufficient)
+    std::vector<uint32_t> compileRoute(const Key& key) const{
+        std::vector<uint32_t> route;
+        auto exactIt = exact.find(key);
+        if (exactIt != exact.end()) route = exactIt->second;
+        for (auto const &r : ranges){
+            if (!(key < r.low) && !(r.high < key)) route.push_back(r.id);
+        }
+        for (auto const &p : predicates){
+            if (p.predicate(key)) route.push_back(p.id);
+        }
+        //execute slots in order of connection, as an unkeyed signal would
+        std::sort(route.begin(), route.end());
+        return route;
+    }
+
+    //the route cache is cleared, rather than growing, once it holds this many keys
+    static const size_t maxRoutes{4096};
+
+    details::SignalImpl<Args...> signalImpl;
+    details::SharedMutex routeLock;
+    std::unordered_map<Key, std::vector<uint32_t>> exact;
+    std::vector<RangeSubscription> ranges;
+    std::vector<PredicateSubscription> predicates;
+    //memoized slots for each key emitted since the subscriptions last changed
+    std::unordered_map<Key, Route> routes;
+    //incremented (under routeLock) whenever the subscriptions change
+    uint64_t generation{0};
+};
+
+}
+
+#endif /* BSIGNALS_KEYEDSIGNAL_HPP */
@@ -0,0 +1,71 @@
+/*
+ * File:   Metrics.h
+ * Author: Barath Kannan
+ * Snapshots of the optional instrumentation of slots (enabled per signal
+ * with Signal::enableMetrics) and of the thread pool's spokes. Latencies are
+ * kept in log bucketed histograms with 8 buckets per power of 2, so any
+ * value is reported to within 12.5%.
+ * Created on 20 October 2026, 4:40 AM
+ */
+
+#ifndef BSIGNALS_METRICS_H
+#define BSIGNALS_METRICS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "BSignals/ExecutorScheme.h"
+
+namespace BSignals{
+
+struct HistogramSnapshot{
+    //number of values recorded in each bucket
+    std::vector<uint64_t> buckets;
+    uint64_t count{0};
+
+    //upper bound of the bucket holding the given percentile (0 to 100) of values
+    uint64_t getPercentile(double percentile) const;
+
+    //upper bound of the highest non empty bucket
+    uint64_t getMax() const;
+
+    //mean of the values, taking each as the midpoint of its bucket
+    double getMean() const;
+
+    void merge(const HistogramSnapshot& that);
+
+    static uint64_t getBucketLowerBound(size_t bucket);
+    static uint64_t getBucketUpperBound(size_t bucket);
+};
+
+//all times are in nanoseconds
+struct SlotMetricsSnapshot{
+    int slotId;
+    ExecutorScheme scheme;
+    //time spent in the slot function
+    HistogramSnapshot executionTime;
+    //time from emission until the slot function is invoked, and emissions
+    //queued and taken from the queue (strand and keyed strand slots only)
+    HistogramSnapshot sojournTime;
+    uint64_t enqueued{0};
+    uint64_t dequeued{0};
+    uint64_t depth{0};
+};
+
+struct SpokeMetricsSnapshot{
+    uint64_t enqueued{0};
+    uint64_t dequeued{0};
+    uint64_t depth{0};
+};
+
+//counting of thread pool tasks posted to and taken from each spoke (off by
+//default, as it adds an atomic increment to both). Only the tasks of
+//instrumented slots (those with metrics, or of a policy which traces slots)
+//are counted, so uninstrumented slots never check whether it is enabled
+void enableThreadPoolMetrics(bool enable);
+
+std::vector<SpokeMetricsSnapshot> getThreadPoolMetrics();
+
+}
+
+#endif /* BSIGNALS_METRICS_H */
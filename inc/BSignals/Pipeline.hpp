@@ -0,0 +1,216 @@
+/*
+ * File:   Pipeline.hpp
+ * Author: Barath Kannan
+ * Composable operators for slots. Stages are chained with operator| and
+ * fused at compile time into a single callable, which is connected to a
+ * signal like any other slot:
+ *     source.connectSlot(scheme, filter(p) | map(f) | forwardTo(sink));
+ * Each emission costs one slot invocation (and one queue hop, for queued
+ * schemes) for the whole chain, intermediate stages are plain inlined calls.
+ * Created on 19 October 2026, 9:40 PM
+ */
+
+#ifndef BSIGNALS_PIPELINE_HPP
+#define BSIGNALS_PIPELINE_HPP
+
+#include <atomic>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include "BSignals/Signal.hpp"
+
+namespace BSignals{ namespace details{
+
+//a stage passes (possibly transformed) arguments to the next callable
+struct PipelineStage{};
+//a terminated pipeline, which can be connected as a slot
+struct PipelineCallable{};
+
+template <typename T>
+using IsPipelineStage = std::is_base_of<PipelineStage, typename std::decay<T>::type>;
+
+template <typename T>
+using IsPipelineCallable = std::is_base_of<PipelineCallable, typename std::decay<T>::type>;
+
+template <typename P>
+class FilterStage : public PipelineStage{
+public:
+    FilterStage(P p) : predicate(std::move(p)){}
+
+    template <typename Next, typename... T>
+    inline void apply(Next& next, T&&... t){
+        if (predicate(t...)) next(std::forward<T>(t)...);
+    }
+
+private:
+    P predicate;
+};
+
+template <typename F>
+class MapStage : public PipelineStage{
+public:
+    MapStage(F f) : func(std::move(f)){}
+
+    template <typename Next, typename... T>
+    inline void apply(Next& next, T&&... t){
+        next(func(std::forward<T>(t)...));
+    }
+
+private:
+    F func;
+};
+
+//the first emission that fails the predicate closes the stage for good
+template <typename P>
+class TakeWhileStage : public PipelineStage{
+public:
+    TakeWhileStage(P p) : predicate(std::move(p)){}
+
+    TakeWhileStage(const TakeWhileStage& that)
+    : predicate(that.predicate), open(that.open.load(std::memory_order_relaxed)){}
+
+    template <typename Next, typename... T>
+    inline void apply(Next& next, T&&... t){
+        if (!open.load(std::memory_order_relaxed)) return;
+        if (predicate(t...)) next(std::forward<T>(t)...);
+        else open.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    P predicate;
+    std::atomic<bool> open{true};
+};
+
+template <typename Policy, typename... Args>
+class ForwardTo : public PipelineCallable{
+public:
+    ForwardTo(BasicSignal<Policy, Args...>& s) : signal(&s){}
+
+    template <typename... T>
+    inline void operator()(T&&... t){
+        signal->emitSignal(t...);
+    }
+
+private:
+    BasicSignal<Policy, Args...>* signal;
+};
+
+template <typename F>
+class Sink : public PipelineCallable{
+public:
+    Sink(F f) : func(std::move(f)){}
+
+    template <typename... T>
+    inline void operator()(T&&... t){
+        func(std::forward<T>(t)...);
+    }
+
+private:
+    F func;
+};
+
+//a stage bound to its downstream callable
+template <typename Stage, typename Next>
+class FusedStage : public PipelineCallable{
+public:
+    FusedStage(Stage s, Next n) : stage(std::move(s)), next(std::move(n)){}
+
+    template <typename... T>
+    inline void operator()(T&&... t){
+        stage.apply(next, std::forward<T>(t)...);
+    }
+
+private:
+    Stage stage;
+    Next next;
+};
+
+//a chain of stages which hasn't been terminated yet
+template <typename... Stages>
+class PartialPipeline{
+public:
+    PartialPipeline(std::tuple<Stages...> s) : stages(std::move(s)){}
+
+    template <typename Stage>
+    PartialPipeline<Stages..., Stage> append(Stage&& stage) &&{
+        return PartialPipeline<Stages..., Stage>(std::tuple_cat(std::move(stages), std::make_tuple(std::move(stage))));
+    }
+
+    template <typename Next>
+    auto bind(Next&& next) &&{
+        return bindFrom(std::integral_constant<size_t, sizeof...(Stages)>(), std::move(next));
+    }
+
+private:
+    //binds stages right to left, so the first stage ends up outermost
+    template <typename Next>
+    Next bindFrom(std::integral_constant<size_t, 0>, Next&& next){
+        return std::move(next);
+    }
+
+    template <size_t I, typename Next>
+    auto bindFrom(std::integral_constant<size_t, I>, Next&& next){
+        typedef typename std::tuple_element<I-1, std::tuple<Stages...>>::type Stage;
+        return bindFrom(std::integral_constant<size_t, I-1>(),
+            FusedStage<Stage, Next>(std::move(std::get<I-1>(stages)), std::move(next)));
+    }
+
+    std::tuple<Stages...> stages;
+};
+
+template <typename A, typename B, typename = typename std::enable_if<IsPipelineStage<A>::value && IsPipelineStage<B>::value>::type>
+PartialPipeline<typename std::decay<A>::type, typename std::decay<B>::type> operator|(A&& a, B&& b){
+    return PartialPipeline<typename std::decay<A>::type, typename std::decay<B>::type>(std::make_tuple(std::forward<A>(a), std::forward<B>(b)));
+}
+
+template <typename... Stages, typename B, typename = typename std::enable_if<IsPipelineStage<B>::value>::type>
+PartialPipeline<Stages..., typename std::decay<B>::type> operator|(PartialPipeline<Stages...> a, B&& b){
+    return std::move(a).append(typename std::decay<B>::type(std::forward<B>(b)));
+}
+
+template <typename A, typename B, typename = typename std::enable_if<IsPipelineStage<A>::value && IsPipelineCallable<B>::value>::type>
+FusedStage<typename std::decay<A>::type, typename std::decay<B>::type> operator|(A&& a, B&& b){
+    return FusedStage<typename std::decay<A>::type, typename std::decay<B>::type>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template <typename... Stages, typename B, typename = typename std::enable_if<IsPipelineCallable<B>::value>::type>
+auto operator|(PartialPipeline<Stages...> a, B&& b){
+    return std::move(a).bind(typename std::decay<B>::type(std::forward<B>(b)));
+}
+
+}
+
+//passes emissions for which predicate(args...) is true
+template <typename P>
+details::FilterStage<typename std::decay<P>::type> filter(P&& predicate){
+    return details::FilterStage<typename std::decay<P>::type>(std::forward<P>(predicate));
+}
+
+//passes func(args...) in place of the arguments, func must return a value
+template <typename F>
+details::MapStage<typename std::decay<F>::type> map(F&& func){
+    return details::MapStage<typename std::decay<F>::type>(std::forward<F>(func));
+}
+
+//passes emissions until predicate(args...) is first false, then none
+template <typename P>
+details::TakeWhileStage<typename std::decay<P>::type> takeWhile(P&& predicate){
+    return details::TakeWhileStage<typename std::decay<P>::type>(std::forward<P>(predicate));
+}
+
+//terminates a pipeline by emitting on another signal (with any
+//instrumentation policy), which must outlive it
+template <typename Policy, typename... Args>
+details::ForwardTo<Policy, Args...> forwardTo(BasicSignal<Policy, Args...>& signal){
+    return details::ForwardTo<Policy, Args...>(signal);
+}
+
+//terminates a pipeline by calling func
+template <typename F>
+details::Sink<typename std::decay<F>::type> sink(F&& func){
+    return details::Sink<typename std::decay<F>::type>(std::forward<F>(func));
+}
+
+}
+
+#endif /* BSIGNALS_PIPELINE_HPP */
@@ -0,0 +1,144 @@
+/*
+ * File:   SharedMemorySignal.hpp
+ * Author: Barath Kannan
+ * Carries emissions between processes on one host, through a ring in POSIX
+ * shared memory. A SharedMemoryReceiver creates the named ring and owns a
+ * dispatch thread, which emits whatever arrives to the slots connected to it.
+ * A SharedMemoryEmitter in any other process opens the ring by name, and
+ * writes each emission straight into a ring cell (the only copy made before
+ * the slots see it). The dispatch thread sleeps on a futex while the ring is
+ * empty, so an idle receiver costs nothing, and a busy one no syscalls.
+ * Args must be trivially copyable, and both sides must be built with the
+ * same Args.
+ * Created on 20 October 2026, 2:40 AM
+ */
+
+#ifndef BSIGNALS_SHAREDMEMORYSIGNAL_HPP
+#define BSIGNALS_SHAREDMEMORYSIGNAL_HPP
+
+#include <string>
+#include <thread>
+#include <atomic>
+#include <utility>
+#include <functional>
+#include "BSignals/Signal.hpp"
+#include "BSignals/details/SharedMemoryRegion.h"
+#include "BSignals/details/SharedMemoryRing.hpp"
+#include "BSignals/details/TrivialEmission.hpp"
+
+namespace BSignals{
+
+template <typename... Args>
+class SharedMemoryEmitter{
+public:
+    static_assert(details::AllTriviallyCopyable<Args...>::value, "shared memory signal arguments must be trivially copyable");
+
+    //opens the ring of the receiver created with name (which must begin with '/')
+    //throws std::system_error if it doesn't exist, or std::invalid_argument
+    //if it was created with different Args
+    explicit SharedMemoryEmitter(const std::string& name)
+    : region(name), ring(Ring::attach(region.getData(), region.getSize())){}
+
+    //waits (yielding) while the ring is full
+    void emitSignal(const Args& ... p){
+        while (!ring.tryEmplace(p...)){
+            std::this_thread::yield();
+        }
+    }
+
+    //returns false, dropping the emission, if the ring is full
+    bool tryEmitSignal(const Args& ... p){
+        return ring.tryEmplace(p...);
+    }
+
+    void operator()(const Args& ... p){
+        emitSignal(p...);
+    }
+
+private:
+    typedef details::SharedMemoryRing<details::TrivialEmission<Args...>> Ring;
+
+    SharedMemoryEmitter(const SharedMemoryEmitter&) = delete;
+    void operator=(const SharedMemoryEmitter&) = delete;
+
+    details::SharedMemoryRegion region;
+    Ring ring;
+};
+
+template <typename... Args>
+class SharedMemoryReceiver{
+public:
+    static_assert(details::AllTriviallyCopyable<Args...>::value, "shared memory signal arguments must be trivially copyable");
+
+    //creates a ring of capacity emissions (a power of 2) named name, which
+    //must begin with '/', replacing any stale ring of the same name
+    //throws std::system_error if shared memory can't be created
+    SharedMemoryReceiver(const std::string& name, uint32_t capacity = 4096)
+    : region(name, Ring::getRequiredSize(capacity)), ring(Ring::create(region.getData(), capacity)){
+        dispatchThread = std::thread(&SharedMemoryReceiver::dispatch, this);
+    }
+
+    //emissions still in the ring are discarded
+    ~SharedMemoryReceiver(){
+        running.store(false);
+        ring.interrupt();
+        dispatchThread.join();
+    }
+
+    //slots are executed as though connected to a thread safe signal which
+    //is emitted on the dispatch thread
+    int connectSlot(ExecutorScheme scheme, std::function<void(Args...)> slot){
+        return signal.connectSlot(scheme, slot);
+    }
+
+    template<typename F, typename C>
+    int connectMemberSlot(ExecutorScheme scheme, F&& function, C&& instance){
+        return signal.connectMemberSlot(scheme, std::forward<F>(function), std::forward<C>(instance));
+    }
+
+    void disconnectSlot(int id){
+        signal.disconnectSlot(id);
+    }
+
+    void disconnectAllSlots(){
+        signal.disconnectAllSlots();
+    }
+
+    //invokes DEFERRED slots, as Signal::invokeDeferred
+    void invokeDeferred(){
+        signal.invokeDeferred();
+    }
+
+    uint32_t invokeDeferred(uint32_t maxItems){
+        return signal.invokeDeferred(maxItems);
+    }
+
+private:
+    typedef details::SharedMemoryRing<details::TrivialEmission<Args...>> Ring;
+
+    SharedMemoryReceiver(const SharedMemoryReceiver&) = delete;
+    void operator=(const SharedMemoryReceiver&) = delete;
+
+    void dispatch(){
+        auto emit = [this](const details::TrivialEmission<Args...>& emission){
+            emission.apply([this](const Args& ... p){
+                signal.emitSignal(p...);
+            });
+        };
+        while (running.load()){
+            if (!ring.consume(emit)){
+                ring.wait([this](){return running.load();});
+            }
+        }
+    }
+
+    details::SharedMemoryRegion region;
+    Ring ring;
+    Signal<Args...> signal{true};
+    std::atomic<bool> running{true};
+    std::thread dispatchThread;
+};
+
+}
+
+#endif /* BSIGNALS_SHAREDMEMORYSIGNAL_HPP */
@@ -9,19 +9,23 @@
 #define BSIGNALS_SIGNAL_HPP
 
 #include "BSignals/ExecutorScheme.h"
+#include "BSignals/Metrics.h"
+#include "BSignals/Instrumentation.h"
 #include "BSignals/details/SignalImpl.hpp"
 
 namespace BSignals {
 
-template <typename... Args>
-class Signal {
+//Policy is an instrumentation policy (see BSignals/Instrumentation.h),
+//Signal is a BasicSignal without instrumentation
+template <typename Policy, typename... Args>
+class BasicSignal {
 public:
-    Signal() = default;
+    BasicSignal() = default;
 
-    Signal(bool enforceThreadSafety)
+    BasicSignal(bool enforceThreadSafety)
     : signalImpl(enforceThreadSafety) {}
 
-    ~Signal() {}
+    ~BasicSignal() {}
 
     template<typename F, typename C>
     int connectMemberSlot(ExecutorScheme scheme, F&& function, C&& instance) {
@@ -32,6 +36,27 @@ public:
         return signalImpl.connectSlot(scheme, slot);
     }
 
+    //emissions are handed to a custom executor, which must provide post(task)
+    //and/or dispatch(task) for a void() callable task (e.g. BSignals::EventLoop)
+    //the executor must outlive the connection
+    template<typename Executor, typename F, typename C, typename = typename std::enable_if<details::IsExecutor<Executor>::value>::type>
+    int connectMemberSlot(Executor& executor, F&& function, C&& instance) {
+        return signalImpl.connectMemberSlot(executor, std::forward<F>(function), std::forward<C>(instance));
+    }
+
+    template<typename Executor, typename = typename std::enable_if<details::IsExecutor<Executor>::value>::type>
+    int connectSlot(Executor& executor, std::function<void(Args...)> slot) {
+        return signalImpl.connectSlot(executor, slot);
+    }
+
+    //connect with the KEYED_STRAND scheme, keyFunction(args...) picks the lane
+    //(emissions with equal keys are executed in order). Signals whose first
+    //argument can't be hashed with std::hash must connect keyed slots this way,
+    //connectSlot throws std::invalid_argument for them
+    int connectKeyedSlot(std::function<size_t(const Args&...)> keyFunction, std::function<void(Args...)> slot) {
+        return signalImpl.connectKeyedSlot(keyFunction, slot);
+    }
+
     void disconnectSlot(int id) {
         signalImpl.disconnectSlot(id);
     }
@@ -44,20 +69,53 @@ public:
         signalImpl.emitSignal(p...);
     }
 
+    //emit, and track when every slot has processed the emission
+    CompletionHandle emitAsync(const Args& ... p) {
+        return signalImpl.emitAsync(p...);
+    }
+
     void invokeDeferred() {
         signalImpl.invokeDeferred();
     }
 
+    //invoke at most maxItems deferred emissions, returns the number still queued
+    uint32_t invokeDeferred(uint32_t maxItems) {
+        return signalImpl.invokeDeferred(maxItems);
+    }
+
+    //invoke deferred emissions until timeBudget has elapsed, returns the number still queued
+    template <typename Rep, typename Period>
+    uint32_t invokeDeferred(std::chrono::duration<Rep, Period> timeBudget) {
+        return signalImpl.invokeDeferred(timeBudget);
+    }
+
     void operator()(const Args& ... p) {
         signalImpl(p...);
     }
 
+    //instrument slots connected from now on, see BSignals/Metrics.h
+    void enableMetrics() {
+        signalImpl.enableMetrics();
+    }
+
+    std::vector<SlotMetricsSnapshot> getMetrics() const {
+        return signalImpl.getMetrics();
+    }
+
+    //the policy instance, to read what it has recorded
+    Policy& getInstrumentation() {
+        return signalImpl.getInstrumentation();
+    }
+
 private:
-    BSignals::details::SignalImpl<Args...> signalImpl;
-    Signal<Args...>(const Signal<Args...>& that) = delete;
-    void operator=(const Signal<Args...>&) = delete;
+    BSignals::details::BasicSignalImpl<Policy, Args...> signalImpl;
+    BasicSignal(const BasicSignal& that) = delete;
+    void operator=(const BasicSignal&) = delete;
 };
 
+template <typename... Args>
+using Signal = BasicSignal<NoInstrumentation, Args...>;
+
 } /* namespace BSignals */
 
 #endif /* BSIGNALS_SIGNAL_HPP */
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+ * File:   SignalBus.hpp
+ * Author: Barath Kannan
+ * Named topics, each backed by its own signal. Topic names are interned
+ * once (getTopic), and publishing through the returned handle goes straight
+ * to the topic's signal without any lookup. Names are hierarchical, with
+ * levels separated by '/'. Subscriptions may use wildcards: '*' matches a
+ * single level, and a trailing '#' matches any number of remaining levels.
+ * Wildcards are resolved when a subscription or topic is created, by
+ * connecting the subscriber to the signal of every matching topic, so they
+ * cost nothing per publish. A queued (strand) wildcard subscription has a
+ * single executor, which every matching topic forwards to, so that it keeps
+ * one thread (or set of lanes) and the order of emissions across topics.
+ * Created on 19 October 2026, 11:30 PM
+ */
+
+#ifndef BSIGNALS_SIGNALBUS_HPP
+#define BSIGNALS_SIGNALBUS_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <stdexcept>
+#include "BSignals/Signal.hpp"
+
+namespace BSignals{
+
+template <typename... Args>
+class SignalBus{
+public:
+    //an interned topic, valid for the lifetime of the bus
+    class Topic{
+    public:
+        Topic() = default;
+
+        bool isValid() const{
+            return (signal != nullptr);
+        }
+
+    private:
+        Topic(Signal<Args...>* s) : signal(s){}
+
+        Signal<Args...>* signal{nullptr};
+        friend class SignalBus;
+    };
+
+    SignalBus() = default;
+
+    //thread safety is passed on to the signal of each topic, and is required
+    //if subscriptions can change while publishing
+    SignalBus(bool enforceThreadSafety)
+    : threadSafe(enforceThreadSafety){}
+
+    //returns the topic with this name, creating it (and connecting any
+    //matching wildcard subscriptions) if it doesn't exist yet
+    //topic names must not contain wildcards
+    Topic getTopic(const std::string& name){
+        std::lock_guard<std::mutex> lock(registryLock);
+        auto it = topics.find(name);
+        if (it != topics.end()) return Topic(it->second.get());
+        Signal<Args...>* signal = new Signal<Args...>(threadSafe);
+        topics.emplace(name, std::unique_ptr<Signal<Args...>>(signal));
+        auto levels = splitLevels(name);
+        for (auto &kvpair : subscriptions){
+            if (matches(kvpair.second.pattern, levels)){
+                connect(kvpair.second, signal);
+            }
+        }
+        return Topic(signal);
+    }
+
+    void publish(const Topic& topic, const Args& ... p){
+        topic.signal->emitSignal(p...);
+    }
+
+    //subscribe slot to every existing and future topic matching pattern
+    //returns an id for unsubscribe
+    //throws std::invalid_argument if '#' isn't the last level of pattern,
+    //for a SINGLE_PRODUCER_STRAND subscription with wildcards (its topics
+    //may be published from different threads), or for a deferred scheme (the
+    //bus's signals are never invoked, so it would never run), or for a
+    //KEYED_STRAND subscription without a hashable first argument
+    int subscribe(const std::string& pattern, ExecutorScheme scheme, std::function<void(Args...)> slot){
+        if (scheme == ExecutorScheme::DEFERRED_SYNCHRONOUS || scheme == ExecutorScheme::DEFERRED_BUFFERED){
+            throw std::invalid_argument("SignalBus: subscription " + pattern + " can't be deferred");
+        }
+        if (scheme == ExecutorScheme::KEYED_STRAND && !details::IsFirstArgumentHashable<Args...>::value){
+            throw std::invalid_argument("SignalBus: keyed subscription " + pattern + " needs a first argument hashable with std::hash");
+        }
+        auto levels = splitLevels(pattern);
+        bool wildcard = false;
+        for (size_t i=0; i<levels.size(); ++i){
+            if (levels[i] == "#" && i + 1 != levels.size()){
+                throw std::invalid_argument("SignalBus: '#' must be the last level of " + pattern);
+            }
+            if (levels[i] == "#" || levels[i] == "*") wildcard = true;
+        }
+        if (wildcard && scheme == ExecutorScheme::SINGLE_PRODUCER_STRAND){
+            throw std::invalid_argument("SignalBus: wildcard subscription " + pattern + " can't be single producer");
+        }
+        std::lock_guard<std::mutex> lock(registryLock);
+        int id = nextSubscriptionId++;
+        Subscription& subscription = subscriptions[id];
+        subscription.pattern = std::move(levels);
+        subscription.scheme = scheme;
+        subscription.slot = std::move(slot);
+        if (wildcard && (scheme == ExecutorScheme::STRAND || scheme == ExecutorScheme::KEYED_STRAND)){
+            subscription.executor = std::make_shared<Signal<Args...>>();
+            subscription.executor->connectSlot(scheme, subscription.slot);
+        }
+        for (auto &kvpair : topics){
+            if (matches(subscription.pattern, splitLevels(kvpair.first))){
+                connect(subscription, kvpair.second.get());
+            }
+        }
+        return id;
+    }
+
+    void unsubscribe(int id){
+        std::lock_guard<std::mutex> lock(registryLock);
+        auto it = subscriptions.find(id);
+        if (it == subscriptions.end()) return;
+        for (auto &connection : it->second.connections){
+            connection.first->disconnectSlot(connection.second);
+        }
+        subscriptions.erase(it);
+    }
+
+    //number of topics the subscription is currently connected to
+    uint32_t getMatchCount(int id) const{
+        std::lock_guard<std::mutex> lock(registryLock);
+        auto it = subscriptions.find(id);
+        return (it == subscriptions.end() ? 0 : (uint32_t)it->second.connections.size());
+    }
+
+private:
+    SignalBus(const SignalBus&) = delete;
+    void operator=(const SignalBus&) = delete;
+
+    struct Subscription{
+        std::vector<std::string> pattern;
+        ExecutorScheme scheme;
+        std::function<void(Args...)> slot;
+        //set for queued wildcard subscriptions, holding the slot on its
+        //scheme; topics forward to it synchronously
+        std::shared_ptr<Signal<Args...>> executor;
+        std::vector<std::pair<Signal<Args...>*, int>> connections;
+    };
+
+    static std::vector<std::string> splitLevels(const std::string& name){
+        std::vector<std::string> levels;
+        size_t begin = 0;
+        for (;;){
+            size_t end = name.find('/', begin);
+            levels.emplace_back(name, begin, end == std::string::npos ? std::string::npos : end - begin);
+            if (end == std::string::npos) break;
+            begin = end + 1;
+        }
+        return levels;
+    }
+
+    static bool matches(const std::vector<std::string>& pattern, const std::vector<std::string>& levels){
+        for (size_t i=0; i<pattern.size(); ++i){
+            if (pattern[i] == "#") return true;
+            if (i == levels.size()) return false;
+            if (pattern[i] != "*" && pattern[i] != levels[i]) return false;
+        }
+        return (pattern.size() == levels.size());
+    }
+
+    void connect(Subscription& subscription, Signal<Args...>* signal){
+        int slotId;
+        if (subscription.executor){
+            //the forwarder keeps the executor alive for as long as the topic
+            //may still call it
+            std::shared_ptr<Signal<Args...>> executor = subscription.executor;
+            slotId = signal->connectSlot(ExecutorScheme::SYNCHRONOUS, [executor](Args... args){
+                executor->emitSignal(args...);
+            });
+        }
+        else{
+            slotId = signal->connectSlot(subscription.scheme, subscription.slot);
+        }
+        subscription.connections.emplace_back(signal, slotId);
+    }
+
+    bool threadSafe{false};
+    mutable std::mutex registryLock;
+    std::unordered_map<std::string, std::unique_ptr<Signal<Args...>>> topics;
+    std::map<int, Subscription> subscriptions;
+    int nextSubscriptionId{0};
+};
+
+}
+
+#endif /* BSIGNALS_SIGNALBUS_HPP */
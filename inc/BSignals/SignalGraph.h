@@ -0,0 +1,87 @@
+/*
+ * File:   SignalGraph.h
+ * Author: Barath Kannan
+ * Executes a DAG of nodes (typically tasks which emit signals, with
+ * synchronous slots feeding further nodes) with knowledge of its topology.
+ * Linear chains of nodes are collapsed into segments which run inline on a
+ * single worker, and segments are scheduled in topological waves across the
+ * thread pool, with a barrier between waves. Each node is timed, so that
+ * the critical path of the last run can be reported.
+ * Created on 19 October 2026, 10:30 PM
+ */
+
+#ifndef BSIGNALS_SIGNALGRAPH_H
+#define BSIGNALS_SIGNALGRAPH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "BSignals/CompletionHandle.h"
+
+namespace BSignals{
+
+class SignalGraph{
+public:
+    struct NodeTiming{
+        std::string name;
+        uint64_t runs{0};
+        std::chrono::nanoseconds last{0};
+        std::chrono::nanoseconds total{0};
+    };
+
+    //returns the id of the node, used to add edges
+    uint32_t addNode(const std::string& name, std::function<void()> task);
+
+    //to runs after from has completed
+    //throws std::out_of_range for an unknown node
+    void addEdge(uint32_t from, uint32_t to);
+
+    //runs every node once, blocking until the graph has completed
+    //the calling thread runs a segment of each wave itself
+    //throws std::invalid_argument if the graph contains a cycle
+    //throws std::logic_error on a pool thread, where blocking could leave the
+    //pool with no worker to run the remaining segments (use runAsync)
+    void run();
+
+    //runs every node once without blocking, every segment runs on the pool
+    //and each wave is scheduled by the thread which completes the previous one
+    //the graph must outlive the returned handle's completion
+    //throws std::invalid_argument if the graph contains a cycle
+    CompletionHandle runAsync();
+
+    //number of waves the graph is scheduled in (available after run)
+    uint32_t getWaveCount() const;
+
+    //timing of a node, must not be called concurrently with run
+    const NodeTiming& getNodeTiming(uint32_t node) const;
+
+    //longest path through the graph by the node timings of the last run
+    //if length is given, it is set to the sum of the path's timings
+    std::vector<uint32_t> getCriticalPath(std::chrono::nanoseconds* length = nullptr) const;
+
+private:
+    struct Node{
+        std::function<void()> task;
+        std::vector<uint32_t> successors;
+        uint32_t nPredecessors{0};
+        NodeTiming timing;
+    };
+
+    void compile();
+    void runSegment(uint32_t segment);
+    void runWaves(size_t wave, details::CompletionToken done);
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> topologicalOrder;
+    //chains of nodes which are run inline, in order
+    std::vector<std::vector<uint32_t>> segments;
+    //segments which can run concurrently, once the previous wave has completed
+    std::vector<std::vector<uint32_t>> waves;
+    bool compiled{false};
+};
+
+}
+
+#endif /* BSIGNALS_SIGNALGRAPH_H */
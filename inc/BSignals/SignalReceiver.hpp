@@ -0,0 +1,234 @@
+/*
+ * File:   SignalReceiver.hpp
+ * Author: Barath Kannan
+ * Pull based consumer for a signal. Emissions are buffered (by value) on a
+ * lock free queue owned by the receiver, and a consumer either polls for
+ * them, or registers a waiter which is resumed on an executor (inline on the
+ * emitting thread by default) when the next emission arrives. With C++20
+ * coroutines, next() returns an awaitable so consumers can be written as
+ * co_await loops, and a suspended consumer costs no thread.
+ * Each receiver supports a single consumer at a time, and can receive from
+ * a signal with any instrumentation policy.
+ * Created on 19 October 2026, 7:15 PM
+ */
+
+#ifndef BSIGNALS_SIGNALRECEIVER_HPP
+#define BSIGNALS_SIGNALRECEIVER_HPP
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include "BSignals/Signal.hpp"
+#include "BSignals/details/MPSCQueue.hpp"
+#include "BSignals/details/ExecutorSlot.hpp"
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+namespace BSignals{
+
+template <typename... Args>
+class SignalReceiver{
+public:
+    typedef std::tuple<typename std::decay<Args>::type...> ArgsTuple;
+
+    //a one shot continuation, resume(context) is scheduled once an emission
+    //is available. The waiter must remain valid until it has been resumed
+    struct Waiter{
+        void (*resume)(void*);
+        void* context;
+    };
+
+    //waiters are resumed inline, on the emitting thread
+    template <typename Policy>
+    SignalReceiver(BasicSignal<Policy, Args...>& sig)
+    : state(std::make_shared<State>()){
+        connect(sig);
+    }
+
+    //waiters are resumed by handing them to executor (see connectSlot)
+    //the executor must outlive the receiver
+    template <typename Policy, typename Executor, typename = typename std::enable_if<details::IsExecutor<Executor>::value>::type>
+    SignalReceiver(BasicSignal<Policy, Args...>& sig, Executor& executor)
+    : state(std::make_shared<State>()){
+        state->executor = &executor;
+        state->schedule = &scheduleOn<Executor>;
+        connect(sig);
+    }
+
+    //the signal must outlive the receiver
+    //a waiter which is still registered is withdrawn, but one which an
+    //emission on another thread has already taken may still be resumed, so a
+    //waiter should not be registered while the receiver is destroyed
+    ~SignalReceiver(){
+        state->waiter.exchange(nullptr, std::memory_order_acq_rel);
+        disconnect(signal, id);
+    }
+
+    //take the oldest buffered emission, if there is one
+    bool tryReceive(ArgsTuple& out){
+        if (!state->claim()) return false;
+        state->dequeueClaimed(out);
+        return true;
+    }
+
+    //take the oldest buffered emission if there is one and return true,
+    //otherwise register waiter and return false
+    bool receiveOrWait(ArgsTuple& out, Waiter& waiter){
+        if (tryReceive(out)) return true;
+        //release, so that the emitter which takes the waiter sees everything
+        //the consumer did before waiting (e.g. its dequeues)
+        state->waiter.store(&waiter, std::memory_order_release);
+        //pairs with the fence in State::resumeWaiter, so that either this
+        //sees the emission, or the emitter sees the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!state->claim()) return false;
+        //take the waiter back, unless an emitter already has (in which case
+        //it has claimed an emission for the waiter, and will resume it)
+        Waiter* expected = &waiter;
+        if (!state->waiter.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)){
+            state->publish();
+            return false;
+        }
+        state->dequeueClaimed(out);
+        return true;
+    }
+
+    //take the emission that resumed a waiter registered by receiveOrWait
+    //(it was claimed for the waiter before it was resumed)
+    void receiveAfterWait(ArgsTuple& out){
+        state->dequeueClaimed(out);
+    }
+
+#if defined(__cpp_impl_coroutine)
+    class NextAwaitable{
+    public:
+        NextAwaitable(SignalReceiver& r) : receiver(r){}
+
+        bool await_ready(){
+            ready = receiver.tryReceive(result);
+            return ready;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle){
+            waiter.resume = [](void* address){std::coroutine_handle<>::from_address(address).resume();};
+            waiter.context = handle.address();
+            //once the waiter is registered, an emitter can resume the
+            //coroutine (and destroy this) at any time, so this is only
+            //touched again if it was never registered or was taken back
+            bool received = receiver.receiveOrWait(result, waiter);
+            if (received) ready = true;
+            return !received;
+        }
+
+        ArgsTuple await_resume(){
+            if (!ready) receiver.receiveAfterWait(result);
+            return std::move(result);
+        }
+
+    private:
+        SignalReceiver& receiver;
+        Waiter waiter;
+        ArgsTuple result;
+        bool ready{false};
+    };
+
+    //co_await receiver.next() yields the next emission as an ArgsTuple
+    NextAwaitable next(){
+        return NextAwaitable(*this);
+    }
+#endif
+
+private:
+    SignalReceiver(const SignalReceiver&) = delete;
+    void operator=(const SignalReceiver&) = delete;
+
+    //an emission is counted in available only once it has been enqueued, and
+    //must be claimed (by decrementing available) before it is dequeued, so a
+    //claim always has a published emission behind it
+    struct State{
+        //count an enqueued emission, and hand it to a registered waiter
+        void publish(){
+            available.fetch_add(1, std::memory_order_release);
+            resumeWaiter();
+        }
+
+        void resumeWaiter(){
+            for (;;){
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waiter.load(std::memory_order_relaxed) == nullptr) return;
+                //the consumer may have claimed every unit itself
+                if (!claim()) return;
+                Waiter* w = waiter.exchange(nullptr, std::memory_order_acq_rel);
+                if (w){
+                    if (schedule) schedule(executor, w);
+                    else w->resume(w->context);
+                    return;
+                }
+                //the consumer took its waiter back, so return the claim and
+                //recheck, in case a new waiter was registered in between
+                available.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        bool claim(){
+            uint32_t n = available.load(std::memory_order_acquire);
+            while (n != 0){
+                if (available.compare_exchange_weak(n, n-1, std::memory_order_acquire, std::memory_order_acquire)) return true;
+            }
+            return false;
+        }
+
+        void dequeueClaimed(ArgsTuple& out){
+            //a claimed emission is fully enqueued, but the queue may briefly
+            //fail to reach it while an earlier concurrent enqueue completes
+            while (!queue.dequeue(out)){
+                std::this_thread::yield();
+            }
+        }
+
+        details::MPSCQueue<ArgsTuple> queue;
+        std::atomic<Waiter*> waiter{nullptr};
+        void* executor{nullptr};
+        void (*schedule)(void*, Waiter*){nullptr};
+        //number of emissions buffered and not yet claimed
+        std::atomic<uint32_t> available{0};
+    };
+
+    template <typename Executor>
+    static void scheduleOn(void* executor, Waiter* w){
+        //the waiter may not outlive its resumption, so it is copied here
+        details::submitTask(*static_cast<Executor*>(executor), [resume = w->resume, context = w->context](){
+            resume(context);
+        });
+    }
+
+    template <typename Policy>
+    static void disconnectFrom(void* sig, int id){
+        static_cast<BasicSignal<Policy, Args...>*>(sig)->disconnectSlot(id);
+    }
+
+    template <typename Policy>
+    void connect(BasicSignal<Policy, Args...>& sig){
+        std::shared_ptr<State> s = state;
+        id = sig.connectSlot(ExecutorScheme::SYNCHRONOUS, [s](Args... args){
+            s->queue.emplace(std::move(args)...);
+            s->publish();
+        });
+        signal = &sig;
+        disconnect = &disconnectFrom<Policy>;
+    }
+
+    //the signal's type (its policy) is erased, as for the executor
+    void* signal{nullptr};
+    void (*disconnect)(void*, int){nullptr};
+    std::shared_ptr<State> state;
+    int id{-1};
+};
+
+}
+
+#endif /* BSIGNALS_SIGNALRECEIVER_HPP */
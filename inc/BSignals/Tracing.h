@@ -0,0 +1,45 @@
+/*
+ * File:   Tracing.h
+ * Author: Barath Kannan
+ * Tracing of emissions through signals with TracingInstrumentation (see
+ * BSignals/Instrumentation.h). While tracing is started, each emission
+ * records its emit and slot dispatches on the emitting thread and, for
+ * queued slots, the enqueue, the dequeue (or steal, for thread pool tasks
+ * taken from another worker) and the execution on the thread it is handed
+ * to. Events are kept in a ring buffer per thread, so only the most recent
+ * events of each thread are retained.
+ * Created on 20 October 2026, 6:20 AM
+ */
+
+#ifndef BSIGNALS_TRACING_H
+#define BSIGNALS_TRACING_H
+
+#include <ostream>
+#include <string>
+#include <cstdint>
+
+namespace BSignals{
+
+//events of a previous trace are discarded
+//eventsPerThread is rounded up to a power of 2, and each thread keeps one
+//fewer of its most recent events
+void startTracing(uint32_t eventsPerThread = 65536);
+
+//events recorded so far are retained for export
+void stopTracing();
+
+bool isTracing();
+
+//writes the recorded events as Chrome trace event JSON, which can be opened
+//in chrome://tracing or Perfetto. Each handoff of an emission to another
+//thread is drawn as a flow from its enqueue to its execution
+//events recorded concurrently with an export may be torn, so tracing should
+//be stopped first
+void exportChromeTrace(std::ostream& out);
+
+//returns false if the file couldn't be written
+bool exportChromeTrace(const std::string& path);
+
+}
+
+#endif /* BSIGNALS_TRACING_H */
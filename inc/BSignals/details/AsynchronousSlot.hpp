@@ -25,11 +25,16 @@ public:
     }
     
     void execute(const Args& ... args){
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    void executeTracked(CompletionToken token, const Args& ... args){
         sem.acquire();
-        std::thread slotThread([this, args...](){
+        std::thread slotThread([this, token = std::move(token), tuple = typename Slot<Args...>::ArgsTuple(args...)]() mutable{
             if (!checkIfValid || checkIfValid()){
-                this->slotFunction(args...);
+                this->callFuncWithTuple(std::move(tuple), std::index_sequence_for<Args...>());
             }
+            token.reset();
             sem.release();
         });
         slotThread.detach();
@@ -0,0 +1,118 @@
+/*
+ * File:   BufferedDeferredSlot.hpp
+ * Author: Barath Kannan
+ * Deferred slot which stores emitted arguments contiguously, by value, in
+ * per-producer buffers. Each producer lane is double buffered: emission
+ * appends to the front buffer, and invocation swaps it with the (already
+ * drained) back buffer before iterating it linearly. Buffer capacity is
+ * retained between swaps, so a steady emit/drain cycle doesn't allocate.
+ * Created on 19 October 2026, 3:40 PM
+ */
+
+#ifndef BSIGNALS_BUFFEREDDEFERREDSLOT_HPP
+#define BSIGNALS_BUFFEREDDEFERREDSLOT_HPP
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include "BSignals/details/Slot.hpp"
+
+namespace BSignals{ namespace details{
+
+//assigns each emitting thread a fixed index, used to pick a producer lane
+inline uint32_t getProducerIndex(){
+    static std::atomic<uint32_t> nextIndex{0};
+    static thread_local uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+template <typename... Args>
+class BufferedDeferredSlot : public Slot<Args...>{
+public:
+    BufferedDeferredSlot(std::function<void(Args...)> f)
+    : Slot<Args...>(f){}
+
+    void execute(const Args& ... args){
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    void executeTracked(CompletionToken token, const Args& ... args){
+        Lane& lane = lanes[getProducerIndex() & (nLanes - 1)];
+        lockLane(lane);
+        lane.front.emplace_back(std::move(token), args...);
+        lane.lock.store(false, std::memory_order_release);
+    }
+
+    //invokes up to maxItems buffered emissions, checking expired before each
+    //each lane's front buffer is swapped out at most once per call
+    //must not be called concurrently
+    //returns the number of emissions invoked
+    template <typename F>
+    uint32_t invokeBuffered(uint32_t maxItems, F&& expired){
+        uint32_t invoked = 0;
+        for (auto &lane : lanes){
+            bool swapped = false;
+            while (invoked < maxItems){
+                if (lane.backPos == lane.back.size()){
+                    if (swapped) break;
+                    lane.back.clear();
+                    lane.backPos = 0;
+                    lockLane(lane);
+                    lane.front.swap(lane.back);
+                    lane.lock.store(false, std::memory_order_release);
+                    swapped = true;
+                    continue;
+                }
+                if (expired()) return invoked;
+                Emission<Args...>& emission = lane.back[lane.backPos++];
+                this->callFuncWithTuple(std::move(emission.args), std::index_sequence_for<Args...>());
+                emission.token.reset();
+                ++invoked;
+            }
+        }
+        return invoked;
+    }
+
+    //number of emissions not yet invoked
+    //must not be called concurrently with invokeBuffered
+    uint32_t getPending(){
+        uint32_t pending = 0;
+        for (auto &lane : lanes){
+            lockLane(lane);
+            pending += lane.front.size();
+            lane.lock.store(false, std::memory_order_release);
+            pending += lane.back.size() - lane.backPos;
+        }
+        return pending;
+    }
+
+    ExecutorScheme getScheme() const{
+        return ExecutorScheme::DEFERRED_BUFFERED;
+    }
+
+private:
+    struct Lane{
+        //producer side
+        std::atomic<bool> lock{false};
+        std::vector<Emission<Args...>> front;
+        //consumer side
+        std::vector<Emission<Args...>> back;
+        size_t backPos{0};
+        char pad[64];
+    };
+
+    inline void lockLane(Lane& lane){
+        while (lane.lock.exchange(true, std::memory_order_acquire)){
+            std::this_thread::yield();
+        }
+    }
+
+    //must be a power of 2
+    static const uint32_t nLanes{8};
+    std::array<Lane, nLanes> lanes;
+};
+}}
+
+#endif /* BSIGNALS_BUFFEREDDEFERREDSLOT_HPP */
@@ -0,0 +1,101 @@
+/*
+ * File:   CompletionState.h
+ * Author: Barath Kannan
+ * Countdown latch shared between a CompletionHandle and the slots executing
+ * a tracked emission. States are recycled through a lock free pool, so that
+ * tracking an emission doesn't allocate once the pool is warm.
+ * Created on 19 October 2026, 8:30 PM
+ */
+
+#ifndef BSIGNALS_COMPLETIONSTATE_H
+#define BSIGNALS_COMPLETIONSTATE_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace BSignals{ namespace details{
+
+class CompletionState{
+public:
+    //returns a state with one pending count (held by the emitter) and two
+    //references (the handle, and the pending work)
+    static CompletionState* acquire();
+    
+    //the number of states the pool has had to allocate; it stops increasing
+    //once the pool is warm
+    static uint64_t getAllocatedCount();
+
+    void addPending();
+    void countDown();
+    void release();
+
+    bool isComplete() const;
+    void wait();
+    bool waitFor(std::chrono::nanoseconds timeout);
+    void then(std::function<void()> continuation);
+
+private:
+    CompletionState() = default;
+    CompletionState(const CompletionState&) = delete;
+    void operator=(const CompletionState&) = delete;
+
+    void complete();
+
+    std::atomic<uint32_t> pending{0};
+    std::atomic<uint32_t> refs{0};
+
+    std::mutex waitLock;
+    std::condition_variable waitCV;
+    bool done{false};
+    std::function<void()> continuation;
+
+    friend struct CompletionStatePool;
+};
+
+//holds one pending count of its state, which is counted down when the token
+//is destroyed or reset, so that emissions which are discarded (e.g. by
+//disconnection) still complete. A copy takes a pending count of its own, so
+//a token can be captured by a lambda stored in a std::function, and the
+//emission completes once every copy has been released
+class CompletionToken{
+public:
+    CompletionToken() = default;
+
+    explicit CompletionToken(CompletionState* s) : state(s){}
+
+    CompletionToken(const CompletionToken& that) noexcept : state(that.state){
+        if (state) state->addPending();
+    }
+
+    CompletionToken(CompletionToken&& that) noexcept : state(that.state){
+        that.state = nullptr;
+    }
+
+    CompletionToken& operator=(CompletionToken that) noexcept{
+        std::swap(state, that.state);
+        return *this;
+    }
+
+    ~CompletionToken(){
+        reset();
+    }
+
+    void reset(){
+        if (state){
+            state->countDown();
+            state = nullptr;
+        }
+    }
+
+private:
+    CompletionState* state{nullptr};
+};
+
+}}
+
+#endif /* BSIGNALS_COMPLETIONSTATE_H */
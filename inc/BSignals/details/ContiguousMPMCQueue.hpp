@@ -37,6 +37,9 @@
 
 #include <atomic>
 #include <type_traits>
+#include <array>
+#include <new>
+#include <utility>
 
 namespace BSignals{ namespace details{
 template<typename T, size_t N>
@@ -51,7 +54,28 @@ public:
         }
     }
 
+    ~ContiguousMPMCQueue(){
+        size_t head_seq = _head_seq.load(std::memory_order_relaxed);
+        for (size_t i=_tail_seq.load(std::memory_order_relaxed); i!=head_seq; ++i){
+            node_t* node = &_buffer[i & (N-1)];
+            if (node->seq.load(std::memory_order_relaxed) == i + 1) node->item()->~T();
+        }
+    }
+
     bool enqueue(const T& data){
+        return emplace(data);
+    }
+
+    bool enqueue(T&& data){
+        return emplace(std::move(data));
+    }
+
+    //the item is only constructed from args if a cell is claimed, so args
+    //are left untouched if the queue is full
+    //if constructing the item throws, the claimed cell is published as a
+    //hole (skipped by consumers) before the exception is rethrown
+    template <typename... U>
+    bool emplace(U&&... args){
         size_t  head_seq = _head_seq.load(std::memory_order_relaxed);
         while(true){
             node_t*  node     = &_buffer[head_seq & (N-1)];
@@ -60,7 +84,13 @@ public:
 
             if (dif == 0){
                 if (_head_seq.compare_exchange_weak(head_seq, head_seq + 1, std::memory_order_relaxed)) {
-                    node->data = data;
+                    try{
+                        new (node->item()) T(std::forward<U>(args)...);
+                    }
+                    catch (...){
+                        node->seq.store((head_seq + 1) | holeBit, std::memory_order_release);
+                        throw;
+                    }
                     node->seq.store(head_seq + 1, std::memory_order_release);
                     return true;
                 }
@@ -74,6 +104,12 @@ public:
         }
     }
 
+    //true if no cell has been claimed by a producer and not yet dequeued
+    //(a cell can be claimed before its item is ready)
+    bool isEmpty() const{
+        return (_head_seq.load(std::memory_order_acquire) == _tail_seq.load(std::memory_order_acquire));
+    }
+
     bool dequeue(T& data){
         size_t       tail_seq = _tail_seq.load(std::memory_order_relaxed);
         while(true){
@@ -82,11 +118,15 @@ public:
             intptr_t dif      = (intptr_t) node_seq - (intptr_t)(tail_seq + 1);
             if (dif == 0) {
                 if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + 1, std::memory_order_relaxed)) {
-                    data = node->data;
+                    data = std::move(*node->item());
+                    node->item()->~T();
                     node->seq.store(tail_seq + N, std::memory_order_release);
                     return true;
                 }
             }
+            else if (node_seq == ((tail_seq + 1) | holeBit)){
+                skipHole(tail_seq);
+            }
             else if (dif < 0){
                 return false;
             }
@@ -96,11 +136,83 @@ public:
         }
     }
 
+    //dequeue up to maxItems, claiming all of the ready cells with a single CAS
+    //each item is moved out and its cell released before func is invoked with
+    //it (as an rvalue), so a long running func doesn't hold cells from producers
+    //if func throws, the rest of the claimed run is dropped (its cells are
+    //released) and the exception is rethrown
+    //returns the number of items dequeued
+    template <typename F>
+    size_t bulkDequeue(F&& func, size_t maxItems){
+        size_t tail_seq = _tail_seq.load(std::memory_order_relaxed);
+        while(true){
+            size_t count = 0;
+            bool stale = false;
+            bool hole = false;
+            for (; count < maxItems && count < N; ++count){
+                size_t   node_seq = _buffer[(tail_seq + count) & (N-1)].seq.load(std::memory_order_acquire);
+                intptr_t dif      = (intptr_t) node_seq - (intptr_t)(tail_seq + count + 1);
+                if (dif == 0) continue;
+                hole = (node_seq == ((tail_seq + count + 1) | holeBit));
+                stale = (dif > 0);
+                break;
+            }
+            if (hole && count == 0){
+                skipHole(tail_seq);
+                continue;
+            }
+            if (stale && count == 0){
+                tail_seq = _tail_seq.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (count == 0) return 0;
+            if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + count, std::memory_order_relaxed)){
+                size_t released = 0;
+                try{
+                    while (released < count){
+                        node_t* node = &_buffer[(tail_seq + released) & (N-1)];
+                        T item(std::move(*node->item()));
+                        node->item()->~T();
+                        node->seq.store(tail_seq + released + N, std::memory_order_release);
+                        ++released;
+                        func(std::move(item));
+                    }
+                }
+                catch(...){
+                    //the cells are already claimed, so producers would wait on
+                    //them forever if they weren't released here
+                    for (; released < count; ++released){
+                        node_t* node = &_buffer[(tail_seq + released) & (N-1)];
+                        node->item()->~T();
+                        node->seq.store(tail_seq + released + N, std::memory_order_release);
+                    }
+                    throw;
+                }
+                return count;
+            }
+        }
+    }
+
 private:
+    //set in the sequence of a cell whose item couldn't be constructed
+    static constexpr size_t holeBit = size_t(1) << (sizeof(size_t)*8 - 1);
+
+    //releases the hole at tail_seq if it's still at the tail, leaving
+    //tail_seq to be reloaded
+    void skipHole(size_t& tail_seq){
+        if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + 1, std::memory_order_relaxed)){
+            _buffer[tail_seq & (N-1)].seq.store(tail_seq + N, std::memory_order_release);
+            tail_seq = _tail_seq.load(std::memory_order_relaxed);
+        }
+    }
 
     struct node_t{
-        T                     data;
-        std::atomic<size_t>   seq;
+        alignas(T) unsigned char  data[sizeof(T)];
+        std::atomic<size_t>       seq;
+        
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
     };
 
     std::array<node_t, N> _buffer;
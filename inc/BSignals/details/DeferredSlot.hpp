@@ -8,19 +8,39 @@
 #ifndef BSIGNALS_DEFERREDSLOT_HPP
 #define BSIGNALS_DEFERREDSLOT_HPP
 
+#include <atomic>
 #include "BSignals/details/Slot.hpp"
 #include "BSignals/details/MPSCQueue.hpp"
 
 namespace BSignals{ namespace details{
 
+//deferred invocations, tagged with the id of the slot that queued them
+//pending is bumped before an invocation is queued, so it may briefly
+//over-report while an enqueue is in flight
+struct DeferredQueue{
+    typedef std::pair<std::function<void()>, uint32_t> Invocation;
+    MPSCQueue<Invocation> queue;
+    std::atomic<uint32_t> pending{0};
+};
+
 template <typename... Args>
 class DeferredSlot : public Slot<Args...>{
 public:
-    DeferredSlot(std::function<void(Args...)> f, std::shared_ptr<MPSCQueue<std::pair<std::function<void()>, uint32_t>>> dq, uint32_t slotId)
+    DeferredSlot(std::function<void(Args...)> f, std::shared_ptr<DeferredQueue> dq, uint32_t slotId)
     : Slot<Args...>(f), deferredQueue(dq), id(slotId){}
     
     void execute(const Args& ... args){
-        deferredQueue->enqueue({[this, args...](){this->slotFunction(args...);}, id});
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    //the token is released when the invocation runs, or when it is discarded
+    //(either because the slot was disconnected, or the queue destroyed)
+    void executeTracked(CompletionToken token, const Args& ... args){
+        deferredQueue->pending.fetch_add(1, std::memory_order_relaxed);
+        deferredQueue->queue.emplace([this, token = std::move(token), tuple = typename Slot<Args...>::ArgsTuple(args...)]() mutable{
+            this->callFuncWithTuple(std::move(tuple), std::index_sequence_for<Args...>());
+            token.reset();
+        }, id);
     }
 
     ExecutorScheme getScheme() const{
@@ -28,7 +48,7 @@ public:
     }
     
 private:
-    std::shared_ptr<MPSCQueue<std::pair<std::function<void()>, uint32_t>>> deferredQueue{nullptr};
+    std::shared_ptr<DeferredQueue> deferredQueue{nullptr};
     const uint32_t id;
 };
 }}
@@ -0,0 +1,299 @@
+/*
+ * File:   DynamicMPMCQueue.hpp
+ * Author: Barath Kannan
+ * Heap backed variant of ContiguousMPMCQueue with a run-time capacity.
+ * Cells can either be padded to a cache line each, or packed with the cell
+ * index scrambled so that consecutive sequence numbers land on different
+ * cache lines. enqueue_n/dequeue_n claim a run of cells with a single CAS.
+ * Created on 19 October 2026, 9:02 AM
+ */
+
+#ifndef BSIGNALS_DYNAMICMPMCQUEUE_HPP
+#define BSIGNALS_DYNAMICMPMCQUEUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace BSignals{ namespace details{
+
+enum class MPMCLayout{
+    //cells are packed contiguously (same layout as ContiguousMPMCQueue)
+    COMPACT,
+    //each cell is aligned to, and padded out to, a cache line
+    PADDED,
+    //cells are packed, but consecutive sequence numbers are mapped to
+    //different cache lines
+    SCRAMBLED
+};
+
+template<typename T, MPMCLayout L = MPMCLayout::PADDED>
+class DynamicMPMCQueue
+{
+public:
+    static constexpr size_t cacheLineSize = 64;
+
+    //capacity must be a power of 2
+    DynamicMPMCQueue(size_t capacity)
+    : _mask(capacity - 1){
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0){
+            throw std::invalid_argument("size of MPMC queue must be power of 2");
+        }
+        initializeScramble(capacity);
+        size_t bytes = capacity*sizeof(node_t) + cacheLineSize;
+        _storage.reset(new char[bytes]);
+        void* p = _storage.get();
+        _buffer = static_cast<node_t*>(std::align(cacheLineSize, capacity*sizeof(node_t), p, bytes));
+        for (size_t i=0; i<capacity; ++i){
+            new (&_buffer[i]) node_t();
+        }
+        for (size_t i=0; i<capacity; ++i){
+            _buffer[cellIndex(i)].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~DynamicMPMCQueue(){
+        size_t head_seq = _head_seq.load(std::memory_order_relaxed);
+        for (size_t i=_tail_seq.load(std::memory_order_relaxed); i!=head_seq; ++i){
+            node_t* node = &_buffer[cellIndex(i)];
+            if (node->seq.load(std::memory_order_relaxed) == i + 1) node->item()->~T();
+        }
+        for (size_t i=0; i<=_mask; ++i){
+            _buffer[i].~node_t();
+        }
+    }
+
+    size_t capacity() const{
+        return _mask + 1;
+    }
+
+    bool enqueue(const T& data){
+        return emplace(data);
+    }
+
+    bool enqueue(T&& data){
+        return emplace(std::move(data));
+    }
+
+    //the item is only constructed from args if a cell is claimed, so args
+    //are left untouched if the queue is full
+    //if constructing the item throws, the claimed cell is published as a
+    //hole (skipped by consumers) before the exception is rethrown
+    template <typename... U>
+    bool emplace(U&&... args){
+        size_t  head_seq = _head_seq.load(std::memory_order_relaxed);
+        while(true){
+            node_t*  node     = &_buffer[cellIndex(head_seq)];
+            size_t   node_seq = node->seq.load(std::memory_order_acquire);
+            intptr_t dif      = (intptr_t) node_seq - (intptr_t) head_seq;
+
+            if (dif == 0){
+                if (_head_seq.compare_exchange_weak(head_seq, head_seq + 1, std::memory_order_relaxed)) {
+                    try{
+                        new (node->item()) T(std::forward<U>(args)...);
+                    }
+                    catch (...){
+                        node->seq.store((head_seq + 1) | holeBit, std::memory_order_release);
+                        throw;
+                    }
+                    node->seq.store(head_seq + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0){
+                return false;
+            }
+            else{
+                head_seq = _head_seq.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool dequeue(T& data){
+        size_t       tail_seq = _tail_seq.load(std::memory_order_relaxed);
+        while(true){
+            node_t*  node     = &_buffer[cellIndex(tail_seq)];
+            size_t   node_seq = node->seq.load(std::memory_order_acquire);
+            intptr_t dif      = (intptr_t) node_seq - (intptr_t)(tail_seq + 1);
+            if (dif == 0) {
+                if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + 1, std::memory_order_relaxed)) {
+                    data = std::move(*node->item());
+                    node->item()->~T();
+                    node->seq.store(tail_seq + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (node_seq == ((tail_seq + 1) | holeBit)){
+                skipHole(tail_seq);
+            }
+            else if (dif < 0){
+                return false;
+            }
+            else{
+                tail_seq = _tail_seq.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //enqueue up to n items, claiming all of the free cells with a single CAS
+    //returns the number of items enqueued (0 if the queue is full)
+    //if copying an item throws, it and the rest of the claimed cells are
+    //published as holes before the exception is rethrown
+    size_t enqueue_n(const T* data, size_t n){
+        size_t head_seq = _head_seq.load(std::memory_order_relaxed);
+        while(true){
+            //a cell that is free for this round can only be taken by the
+            //producer that claims its sequence number, so counting the free
+            //prefix before the CAS is stable if the CAS succeeds
+            size_t count = 0;
+            bool stale = false;
+            for (; count < n; ++count){
+                size_t   node_seq = _buffer[cellIndex(head_seq + count)].seq.load(std::memory_order_acquire);
+                intptr_t dif      = (intptr_t) node_seq - (intptr_t)(head_seq + count);
+                if (dif < 0) break;
+                if (dif > 0){
+                    stale = true;
+                    break;
+                }
+            }
+            if (stale && count == 0){
+                head_seq = _head_seq.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (count == 0) return 0;
+            if (_head_seq.compare_exchange_weak(head_seq, head_seq + count, std::memory_order_relaxed)){
+                size_t i = 0;
+                try{
+                    for (; i<count; ++i){
+                        node_t* node = &_buffer[cellIndex(head_seq + i)];
+                        new (node->item()) T(data[i]);
+                        node->seq.store(head_seq + i + 1, std::memory_order_release);
+                    }
+                }
+                catch (...){
+                    for (; i<count; ++i){
+                        _buffer[cellIndex(head_seq + i)].seq.store((head_seq + i + 1) | holeBit, std::memory_order_release);
+                    }
+                    throw;
+                }
+                return count;
+            }
+        }
+    }
+
+    //dequeue up to n items, claiming all of the ready cells with a single CAS
+    //returns the number of items dequeued (0 if the queue is empty)
+    size_t dequeue_n(T* data, size_t n){
+        size_t tail_seq = _tail_seq.load(std::memory_order_relaxed);
+        while(true){
+            size_t count = 0;
+            bool stale = false;
+            bool hole = false;
+            for (; count < n; ++count){
+                size_t   node_seq = _buffer[cellIndex(tail_seq + count)].seq.load(std::memory_order_acquire);
+                intptr_t dif      = (intptr_t) node_seq - (intptr_t)(tail_seq + count + 1);
+                if (dif == 0) continue;
+                hole = (node_seq == ((tail_seq + count + 1) | holeBit));
+                stale = (dif > 0);
+                break;
+            }
+            if (hole && count == 0){
+                skipHole(tail_seq);
+                continue;
+            }
+            if (stale && count == 0){
+                tail_seq = _tail_seq.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (count == 0) return 0;
+            if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + count, std::memory_order_relaxed)){
+                for (size_t i=0; i<count; ++i){
+                    node_t* node = &_buffer[cellIndex(tail_seq + i)];
+                    data[i] = std::move(*node->item());
+                    node->item()->~T();
+                    node->seq.store(tail_seq + i + _mask + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+private:
+    //set in the sequence of a cell whose item couldn't be constructed
+    static constexpr size_t holeBit = size_t(1) << (sizeof(size_t)*8 - 1);
+
+    //releases the hole at tail_seq if it's still at the tail, leaving
+    //tail_seq to be reloaded
+    void skipHole(size_t& tail_seq){
+        if (_tail_seq.compare_exchange_weak(tail_seq, tail_seq + 1, std::memory_order_relaxed)){
+            _buffer[cellIndex(tail_seq)].seq.store(tail_seq + _mask + 1, std::memory_order_release);
+            tail_seq = _tail_seq.load(std::memory_order_relaxed);
+        }
+    }
+
+    struct compact_node_t{
+        alignas(T) unsigned char  data[sizeof(T)];
+        std::atomic<size_t>       seq;
+        
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
+    };
+
+    struct alignas(cacheLineSize) padded_node_t{
+        alignas(T) unsigned char  data[sizeof(T)];
+        std::atomic<size_t>       seq;
+        
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
+    };
+
+    typedef typename std::conditional<L == MPMCLayout::PADDED, padded_node_t, compact_node_t>::type node_t;
+
+    static constexpr size_t cellsPerLine = (sizeof(node_t) >= cacheLineSize) ? 1 : cacheLineSize/sizeof(node_t);
+
+    inline void initializeScramble(size_t capacity){
+        if (L != MPMCLayout::SCRAMBLED) return;
+        //round the number of cells per line down to a power of 2
+        size_t perLine = 1;
+        while (perLine*2 <= cellsPerLine) perLine*=2;
+        if (perLine == 1 || capacity/perLine < 2) return;
+        size_t lines = capacity/perLine;
+        while ((size_t(1) << _lineShift) < lines) ++_lineShift;
+        _lineMask = lines - 1;
+        while ((size_t(1) << _cellShift) < perLine) ++_cellShift;
+    }
+
+    //maps a sequence number onto a cell
+    //for the scrambled layout, sequence number s lands on line (s % lines),
+    //at position (s / lines) within that line
+    inline size_t cellIndex(size_t seq) const{
+        size_t pos = seq & _mask;
+        if (L != MPMCLayout::SCRAMBLED || _lineMask == 0) return pos;
+        return ((pos & _lineMask) << _cellShift) | (pos >> _lineShift);
+    }
+
+    const size_t _mask;
+    size_t _lineMask{0};
+    size_t _lineShift{0};
+    size_t _cellShift{0};
+    std::unique_ptr<char[]> _storage;
+    node_t* _buffer{nullptr};
+    char pad0[cacheLineSize];
+    std::atomic<size_t> _head_seq{0};
+    char pad1[cacheLineSize];
+    std::atomic<size_t> _tail_seq{0};
+    char pad2[cacheLineSize];
+
+    DynamicMPMCQueue(const DynamicMPMCQueue&) = delete;
+    void operator=(const DynamicMPMCQueue&) = delete;
+};
+
+}}
+#endif /* BSIGNALS_DYNAMICMPMCQUEUE_HPP */
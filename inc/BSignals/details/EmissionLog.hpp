@@ -0,0 +1,72 @@
+/*
+ * File:   EmissionLog.hpp
+ * Author: Barath Kannan
+ * Layout of an emission trace file, shared by EmissionRecorder and
+ * EmissionReplayer. The file is a header followed by fixed size chunks of
+ * timestamped records. Each recording thread claims whole chunks (with one
+ * atomic increment per chunk) and fills them without further
+ * synchronization, so records are only ordered within a chunk, and a reader
+ * merges them by timestamp.
+ * Created on 20 October 2026, 3:40 AM
+ */
+
+#ifndef BSIGNALS_EMISSIONLOG_HPP
+#define BSIGNALS_EMISSIONLOG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "BSignals/details/TrivialEmission.hpp"
+
+namespace BSignals{ namespace details{
+
+template <typename... Args>
+struct EmissionLog{
+    static const uint64_t logMagic{0x42534947544c4f47ULL};
+    static const uint32_t chunkRecords{1024};
+
+    struct Header{
+        uint64_t magic;
+        uint64_t signature;
+        uint32_t recordSize;
+        uint32_t chunkRecords;
+        uint64_t maxChunks;
+        alignas(64) std::atomic<uint64_t> nChunks;
+        alignas(64) std::atomic<uint64_t> dropped;
+    };
+
+    struct Record{
+        //nanoseconds since the recorder was created
+        uint64_t timestamp;
+        TrivialEmission<Args...> emission;
+    };
+
+    struct alignas(64) Chunk{
+        //records written so far, published after each record
+        std::atomic<uint32_t> count;
+        //index of the recording thread, in order of first emission
+        uint32_t thread;
+    };
+
+    //to catch traces read with different Args
+    static uint64_t getSignature(){
+        return TrivialEmission<Args...>::getSignature();
+    }
+
+    static size_t getChunkSize(){
+        size_t size = sizeof(Chunk) + chunkRecords*sizeof(Record);
+        return (size + 63) & ~size_t(63);
+    }
+
+    static Chunk* getChunk(Header* header, uint64_t index){
+        return reinterpret_cast<Chunk*>(reinterpret_cast<char*>(header) + sizeof(Header) + index*getChunkSize());
+    }
+
+    static Record* getRecords(Chunk* chunk){
+        return reinterpret_cast<Record*>(chunk + 1);
+    }
+};
+
+}}
+
+#endif /* BSIGNALS_EMISSIONLOG_HPP */
@@ -0,0 +1,108 @@
+/*
+ * File:   ExecutorSlot.hpp
+ * Author: Barath Kannan
+ * Slot which hands emissions to a user supplied executor. An executor is any
+ * object with a post(task) member (or dispatch(task), which is preferred if
+ * present), where task is a void() callable. The task is passed as the
+ * lambda itself, so executors that take a template parameter avoid any type
+ * erasure. Tasks share the slot function with the slot, and become no-ops
+ * once the slot has been disconnected, so they can safely outlive both the
+ * slot and the signal.
+ * Created on 19 October 2026, 6:10 PM
+ */
+
+#ifndef BSIGNALS_EXECUTORSLOT_HPP
+#define BSIGNALS_EXECUTORSLOT_HPP
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "BSignals/details/Slot.hpp"
+
+namespace BSignals{ namespace details{
+
+template <typename...>
+using void_t = void;
+
+template <typename Executor, typename = void>
+struct HasPost : std::false_type{};
+
+template <typename Executor>
+struct HasPost<Executor, void_t<decltype(std::declval<Executor&>().post(std::declval<void(*)()>()))>> : std::true_type{};
+
+template <typename Executor, typename = void>
+struct HasDispatch : std::false_type{};
+
+template <typename Executor>
+struct HasDispatch<Executor, void_t<decltype(std::declval<Executor&>().dispatch(std::declval<void(*)()>()))>> : std::true_type{};
+
+template <typename Executor>
+struct IsExecutor : std::integral_constant<bool, HasPost<Executor>::value || HasDispatch<Executor>::value>{};
+
+template <typename Executor, typename Task>
+inline void submitTask(std::true_type, Executor& executor, Task&& task){
+    executor.dispatch(std::forward<Task>(task));
+}
+
+template <typename Executor, typename Task>
+inline void submitTask(std::false_type, Executor& executor, Task&& task){
+    executor.post(std::forward<Task>(task));
+}
+
+//hands task to executor.dispatch if present, otherwise executor.post
+template <typename Executor, typename Task>
+inline void submitTask(Executor& executor, Task&& task){
+    submitTask(HasDispatch<Executor>(), executor, std::forward<Task>(task));
+}
+
+template <typename Executor, typename... Args>
+class ExecutorSlot : public Slot<Args...>{
+public:
+    ExecutorSlot(std::function<void(Args...)> f, Executor& ex)
+    : Slot<Args...>(f), executor(ex), state(std::make_shared<SharedState>(f)){}
+
+    ~ExecutorSlot(){
+        state->connected.store(false, std::memory_order_release);
+    }
+
+    //tasks already handed over are cancelled as soon as the slot is disconnected
+    void markForDeath(){
+        Slot<Args...>::markForDeath();
+        state->connected.store(false, std::memory_order_release);
+    }
+
+    void execute(const Args& ... args){
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    //the token is released when the task runs, or if the executor destroys it
+    void executeTracked(CompletionToken token, const Args& ... args){
+        submitTask(executor, [s = state, token = std::move(token), tuple = typename Slot<Args...>::ArgsTuple(args...)]() mutable{
+            if (s->connected.load(std::memory_order_acquire)){
+                s->invoke(std::move(tuple), std::index_sequence_for<Args...>());
+            }
+            token.reset();
+        });
+    }
+
+private:
+    struct SharedState{
+        SharedState(std::function<void(Args...)> f) : slotFunction(f){}
+
+        template<typename Tuple, std::size_t... Is>
+        void invoke(Tuple&& tuple, std::index_sequence<Is...>){
+            slotFunction(std::get<Is>(std::forward<Tuple>(tuple))...);
+        }
+
+        std::function<void(Args...)> slotFunction;
+        std::atomic<bool> connected{true};
+    };
+
+    Executor& executor;
+    std::shared_ptr<SharedState> state;
+};
+
+}}
+
+#endif /* BSIGNALS_EXECUTORSLOT_HPP */
@@ -0,0 +1,207 @@
+/*
+ * File:   KeyedStrandSlot.hpp
+ * Author: Barath Kannan
+ * Slot which hashes a key from the emitted arguments (the first argument by
+ * default) to one of a fixed number of serial lanes. Lanes have no thread of
+ * their own: a lane with queued emissions is scheduled on the thread pool,
+ * and drained by one pool task at a time. Emissions for a key are executed
+ * in order, while different lanes execute in parallel.
+ * Created on 20 October 2026, 1:10 AM
+ */
+
+#ifndef BSIGNALS_KEYEDSTRANDSLOT_HPP
+#define BSIGNALS_KEYEDSTRANDSLOT_HPP
+
+#include <atomic>
+#include <array>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "BSignals/details/Slot.hpp"
+#include "BSignals/details/MPSCQueue.hpp"
+#include "BSignals/details/WheeledThreadPool.h"
+
+namespace BSignals{ namespace details{
+
+template <typename T>
+inline auto isHashable(int) -> decltype(std::hash<T>()(std::declval<const T&>()), std::true_type());
+
+template <typename T>
+inline std::false_type isHashable(long);
+
+//true if the first argument can be hashed with std::hash, which is required
+//to key a slot without a key function
+template <typename... Args>
+struct IsFirstArgumentHashable : std::false_type{};
+
+template <typename First, typename... Rest>
+struct IsFirstArgumentHashable<First, Rest...> : decltype(isHashable<First>(0)){};
+
+template <typename First, typename... Rest>
+inline size_t hashFirstArgument(std::true_type, const First& first, const Rest& ...){
+    return std::hash<First>()(first);
+}
+
+//never called, slots without a key function can't be constructed
+template <typename... Args>
+inline size_t hashFirstArgument(std::false_type, const Args& ...){
+    return 0;
+}
+
+//Instrumented slots record queue metrics if they are given them (setMetrics)
+//before the first emission, and trace events for traced emissions
+template <bool Instrumented, typename... Args>
+class BasicKeyedStrandSlot : public Slot<Args...>{
+public:
+    typedef std::function<size_t(const Args&...)> KeyFunction;
+
+    BasicKeyedStrandSlot(std::function<void(Args...)> f, KeyFunction k)
+    : Slot<Args...>(f), keyFunction(k), state(std::make_shared<SharedState>(f)){
+        WheeledThreadPool::startup();
+    }
+    
+    //without a key function, the first argument is hashed with std::hash
+    BasicKeyedStrandSlot(std::function<void(Args...)> f)
+    : BasicKeyedStrandSlot(f, nullptr){
+        static_assert(IsFirstArgumentHashable<Args...>::value, "KEYED_STRAND slots without a key function need a first argument hashable with std::hash");
+    }
+
+    //emissions still queued are discarded
+    ~BasicKeyedStrandSlot(){
+        state->connected.store(false, std::memory_order_release);
+    }
+
+    void markForDeath(){
+        Slot<Args...>::markForDeath();
+        state->connected.store(false, std::memory_order_release);
+    }
+
+    void setMetrics(std::shared_ptr<SlotMetrics> m){
+        state->metrics = m;
+        Slot<Args...>::setMetrics(std::move(m));
+    }
+
+    void setId(uint32_t slotId){
+        state->id = slotId;
+        Slot<Args...>::setId(slotId);
+    }
+
+    void execute(const Args& ... args){
+        executeTracked(CompletionToken(), args...);
+    }
+
+    void executeTracked(CompletionToken token, const Args& ... args){
+        size_t key = keyFunction ? keyFunction(args...) : hashFirstArgument(IsFirstArgumentHashable<Args...>(), args...);
+        Lane& lane = state->lanes[key & (nLanes - 1)];
+        if (Instrumented){
+            uint64_t traceId = Tracer::getCurrentEmission();
+            if (traceId) Tracer::record(TraceEventType::ENQUEUE, traceId, state->id);
+            if (state->metrics) state->metrics->enqueued.increment();
+            lane.queue.emplace(std::move(token), state->metrics ? getMetricsTimestamp() : 0, traceId, args...);
+        }
+        else{
+            lane.queue.emplace(std::move(token), args...);
+        }
+        lane.pending.fetch_add(1);
+        if (!lane.scheduled.exchange(true)) schedule(state, lane);
+    }
+
+private:
+    struct Lane{
+        MPSCQueue<BasicEmission<Instrumented, Args...>> queue;
+        //emissions fully enqueued and not yet dequeued
+        std::atomic<uint32_t> pending{0};
+        //true while a pool task owns the lane
+        std::atomic<bool> scheduled{false};
+    };
+
+    //must be a power of 2
+    static const uint32_t nLanes{16};
+    //emissions drained per pool task, before handing the worker back
+    static const uint32_t batchSize{64};
+
+    struct SharedState{
+        SharedState(std::function<void(Args...)> f) : slotFunction(f){}
+
+        template<typename Tuple, std::size_t... Is>
+        void invoke(Tuple&& tuple, std::index_sequence<Is...>){
+            slotFunction(std::get<Is>(std::forward<Tuple>(tuple))...);
+        }
+
+        std::function<void(Args...)> slotFunction;
+        std::atomic<bool> connected{true};
+        std::shared_ptr<SlotMetrics> metrics;
+        uint32_t id{0};
+        std::array<Lane, nLanes> lanes;
+    };
+
+    //the task holds the state, so a lane can outlive its slot
+    static void schedule(const std::shared_ptr<SharedState>& s, Lane& lane){
+        auto task = [s, &lane](){
+            drain(s, lane);
+        };
+        if (Instrumented) WheeledThreadPool::runCounted(task);
+        else WheeledThreadPool::run(task);
+    }
+
+    static void drain(const std::shared_ptr<SharedState>& s, Lane& lane){
+        auto invoke = [&s](BasicEmission<Instrumented, Args...>&& emission){
+            if (Instrumented && s->metrics){
+                s->metrics->dequeued.increment();
+                s->metrics->sojournTime.record(getMetricsTimestamp() - emission.getEnqueueTime());
+            }
+            if (Instrumented && emission.getTraceId()){
+                traceExecution(s, emission);
+            }
+            else if (s->connected.load(std::memory_order_acquire)){
+                s->invoke(std::move(emission.args), std::index_sequence_for<Args...>());
+            }
+            emission.token.reset();
+        };
+        uint32_t n = 0;
+        for (;;){
+            while (lane.pending.load() > 0){
+                //still scheduled, so the lane is resumed by the new task
+                if (n++ == batchSize){
+                    schedule(s, lane);
+                    return;
+                }
+                //a producer ahead of this one in the queue may still be linking
+                while (!lane.queue.bulkDequeue([&lane, &invoke](BasicEmission<Instrumented, Args...>&& emission){
+                    lane.pending.fetch_sub(1);
+                    invoke(std::move(emission));
+                }, 1)){
+                    std::this_thread::yield();
+                }
+            }
+            //release the lane, unless an emission arrived after the last check
+            //and its producer saw the lane as still scheduled
+            lane.scheduled.store(false);
+            if (lane.pending.load() == 0 || lane.scheduled.exchange(true)) return;
+        }
+    }
+
+    static void traceExecution(const std::shared_ptr<SharedState>& s, BasicEmission<Instrumented, Args...>& emission){
+        Tracer::record(Tracer::isRunningStolenTask() ? TraceEventType::STEAL : TraceEventType::DEQUEUE, emission.getTraceId(), s->id);
+        if (s->connected.load(std::memory_order_acquire)){
+            Tracer::record(TraceEventType::EXECUTE_BEGIN, emission.getTraceId(), s->id);
+            s->invoke(std::move(emission.args), std::index_sequence_for<Args...>());
+            Tracer::record(TraceEventType::EXECUTE_END, emission.getTraceId(), s->id);
+        }
+    }
+
+    KeyFunction keyFunction;
+    std::shared_ptr<SharedState> state;
+};
+
+template <typename... Args>
+using KeyedStrandSlot = BasicKeyedStrandSlot<false, Args...>;
+
+template <typename... Args>
+using InstrumentedKeyedStrandSlot = BasicKeyedStrandSlot<true, Args...>;
+
+}}
+
+#endif /* BSIGNALS_KEYEDSTRANDSLOT_HPP */
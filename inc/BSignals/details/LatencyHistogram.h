@@ -0,0 +1,161 @@
+/*
+ * File:   LatencyHistogram.h
+ * Author: Barath Kannan
+ * Histogram and counter with a shard per recording thread, allocated the
+ * first time the thread records, so recording never contends on a cache
+ * line (each shard has a single writer). Shards are merged when a snapshot
+ * is taken. Values are bucketed by their power of 2 and their next 3 bits,
+ * as in an HDR histogram with one significant digit.
+ * Created on 20 October 2026, 4:50 AM
+ */
+
+#ifndef BSIGNALS_LATENCYHISTOGRAM_H
+#define BSIGNALS_LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "BSignals/Metrics.h"
+
+namespace BSignals{ namespace details{
+
+//thread local cache of the shard last used by the thread, for each of a few
+//ThreadShards (by id, so entries of destroyed instances are never matched)
+struct ShardCacheEntry{
+    uint64_t id{0};
+    void* shard{nullptr};
+};
+static const uint32_t shardCacheSize{16};
+ShardCacheEntry* getShardCache();
+uint64_t getNextShardsId();
+
+//a Shard for each thread which calls local(), merged by forEach
+template <typename Shard>
+class ThreadShards{
+public:
+    ThreadShards() : id(getNextShardsId()){}
+
+    ~ThreadShards(){
+        for (Node* n = head.load(std::memory_order_acquire); n;){
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    //only the calling thread writes to its shard
+    Shard& local(){
+        ShardCacheEntry& entry = getShardCache()[id & (shardCacheSize - 1)];
+        if (entry.id != id){
+            entry.id = id;
+            entry.shard = &findOrAdd();
+        }
+        return *static_cast<Shard*>(entry.shard);
+    }
+
+    template <typename F>
+    void forEach(F f) const{
+        for (Node* n = head.load(std::memory_order_acquire); n; n = n->next){
+            f(n->shard);
+        }
+    }
+
+private:
+    ThreadShards(const ThreadShards&) = delete;
+    void operator=(const ThreadShards&) = delete;
+
+    //padded rather than aligned (over aligned new needs C++17), so that the
+    //shards of neighbouring allocations don't share a cache line
+    struct Node{
+        Shard shard;
+        //a thread which reuses the id of an exited thread takes over its shard
+        std::thread::id owner;
+        Node* next{nullptr};
+        char padding[64];
+    };
+
+    //on a cache miss, the thread may already have a shard
+    Shard& findOrAdd(){
+        std::thread::id self = std::this_thread::get_id();
+        for (Node* n = head.load(std::memory_order_acquire); n; n = n->next){
+            if (n->owner == self) return n->shard;
+        }
+        Node* node = new Node;
+        node->owner = self;
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+        return node->shard;
+    }
+
+    std::atomic<Node*> head{nullptr};
+    const uint64_t id;
+};
+
+//nanoseconds on the steady clock, for measuring intervals
+inline uint64_t getMetricsTimestamp(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class LatencyHistogram{
+public:
+    static const uint32_t subBucketBits{3};
+    static const uint32_t subBuckets{1u << subBucketBits};
+    static const uint32_t nBuckets{subBuckets + (64 - subBucketBits)*subBuckets};
+
+    static uint32_t getBucket(uint64_t value){
+        if (value < subBuckets) return (uint32_t)value;
+        uint32_t exponent = 63 - __builtin_clzll(value);
+        uint32_t shift = exponent - subBucketBits;
+        return subBuckets + shift*subBuckets + (uint32_t)((value >> shift) & (subBuckets - 1));
+    }
+
+    //the shard has a single writer, so doesn't need an atomic increment
+    void record(uint64_t value){
+        auto &cell = shards.local().buckets[getBucket(value)];
+        cell.store(cell.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshot() const;
+
+private:
+    struct Shard{
+        std::array<std::atomic<uint64_t>, nBuckets> buckets{};
+    };
+    ThreadShards<Shard> shards;
+};
+
+class ShardedCounter{
+public:
+    void increment(){
+        auto &value = shards.local().value;
+        value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const;
+
+private:
+    struct Shard{
+        std::atomic<uint64_t> value{0};
+    };
+    ThreadShards<Shard> shards;
+};
+
+//instrumentation of one slot, shared by the slot and the signal's registry
+struct SlotMetrics{
+    SlotMetrics(int id, ExecutorScheme s) : slotId(id), scheme(s){}
+
+    SlotMetricsSnapshot snapshot() const;
+
+    const int slotId;
+    const ExecutorScheme scheme;
+    LatencyHistogram executionTime;
+    LatencyHistogram sojournTime;
+    ShardedCounter enqueued;
+    ShardedCounter dequeued;
+};
+
+}}
+
+#endif /* BSIGNALS_LATENCYHISTOGRAM_H */
@@ -30,7 +30,10 @@
  * Author: Barath Kannan
  * This is an adaptation of https://github.com/mstump/queues/blob/master/include/mpsc-queue.hpp
  * The queue has been modified such that it can also be used as a blocking queue
- * Aligned storage was removed, was causing segmentation faults and didn't improve performance
+ * Items are held in raw node storage and moved in/out, so T need only be move constructible
+ * and move assignable (the node data is no longer default constructed)
+ * Producers bypass the cache while the list holds items, so that the items from any one
+ * producer are always dequeued in the order they were enqueued
  * Created on 14 June 2016, 1:14 AM
  */
 
@@ -44,6 +47,9 @@
 #include <chrono>
 #include <thread>
 #include <assert.h>
+#include <new>
+#include <utility>
+#include <cstdint>
 #include "BSignals/details/ContiguousMPMCQueue.hpp"
 
 namespace BSignals{ namespace details{
@@ -55,24 +61,37 @@ public:
     MPSCQueue(){}
 
     ~MPSCQueue(){
-        T output;
-        while(this->dequeue(output));
-        listNode* front = _head.load(std::memory_order_relaxed);
-        delete front;
+        listNode* tail = _tail.load(std::memory_order_relaxed);
+        while (listNode* next = tail->next.load(std::memory_order_relaxed)){
+            next->item()->~T();
+            delete tail;
+            tail = next;
+        }
+        delete tail;
     }
     
     void enqueue(const T& input){
-        if (fastEnqueue(input)) return;
-        slowEnqueue(input);
+        emplace(input);
+    }
+    
+    void enqueue(T&& input){
+        emplace(std::move(input));
+    }
+    
+    //construct the item in place (in the cache if there is room)
+    template <typename... U>
+    void emplace(U&&... args){
+        if (fastEmplace(std::forward<U>(args)...)) return;
+        slowEmplace(std::forward<U>(args)...);
     }
     
     //only try to enqueue to the cache
     bool fastEnqueue(const T& input){
-        if (_cache.enqueue(input)){    
-            if (waitingReader.load(std::memory_order_acquire)) _cv.notify_one();
-            return true;
-        }
-        return false;
+        return fastEmplace(input);
+    }
+    
+    bool fastEnqueue(T&& input){
+        return fastEmplace(std::move(input));
     }
 
     bool dequeue(T& output){
@@ -84,14 +103,65 @@ public:
         return _cache.dequeue(output);
     }
     
+    //dequeue up to maxItems, invoking func with each (as an rvalue)
+    //the cache run is claimed with a single CAS, and the list run is
+    //detached with a single store of the tail
+    //if func throws, the rest of the claimed run is dropped and the exception
+    //is rethrown
+    //returns the number of items dequeued
+    template <typename F>
+    size_t bulkDequeue(F&& func, size_t maxItems = SIZE_MAX){
+        size_t count = _cache.bulkDequeue(func, maxItems);
+        if (count == maxItems) return count;
+        
+        listNode* tail = _tail.load(std::memory_order_relaxed);
+        listNode* last = tail;
+        size_t listCount = 0;
+        for (listNode* next; listCount < maxItems - count && (next = last->next.load(std::memory_order_acquire)) != nullptr; ++listCount){
+            last = next;
+        }
+        if (listCount == 0) return count;
+        //older items may still be being written to the cache
+        if (!_cache.isEmpty()) return count;
+        _tail.store(last, std::memory_order_release);
+        _listSize.fetch_sub(listCount, std::memory_order_release);
+        
+        //last becomes the new stub, every node before it is now exclusively owned
+        try{
+            while (tail != last){
+                listNode* next = tail->next.load(std::memory_order_relaxed);
+                delete tail;
+                tail = next;
+                func(std::move(*tail->item()));
+                tail->item()->~T();
+            }
+        }
+        catch(...){
+            //the detached nodes are no longer reachable from the queue
+            tail->item()->~T();
+            while (tail != last){
+                listNode* next = tail->next.load(std::memory_order_relaxed);
+                delete tail;
+                tail = next;
+                tail->item()->~T();
+            }
+            throw;
+        }
+        return count + listCount;
+    }
+    
     //transfer as many items as possible to the cache
+    //items are only unlinked once the cache has accepted them
     void transferMaxToCache(){
-        T output;
-        while (slowDequeue(output)){
-            if (!fastEnqueue(output)){
-                slowEnqueue(output);
-                break;
-            }
+        listNode* tail = _tail.load(std::memory_order_relaxed);
+        listNode* next;
+        while ((next = tail->next.load(std::memory_order_acquire)) != nullptr){
+            if (!_cache.emplace(std::move(*next->item()))) break;
+            next->item()->~T();
+            _tail.store(next, std::memory_order_release);
+            _listSize.fetch_sub(1, std::memory_order_release);
+            delete tail;
+            tail = next;
         }
     }
     
@@ -104,38 +174,95 @@ public:
         waitingReader.store(false, std::memory_order_release);
     }
     
+    //blocks until the queue holds an item or unblock has been called, so
+    //that a consumer can wait without an item to dequeue into
+    void waitForItems(){
+        std::unique_lock<std::mutex> lock(_mutex);
+        waitingReader.store(true, std::memory_order_release);
+        while (isEmpty() && !_unblocked){
+            _cv.wait(lock);
+        }
+        waitingReader.store(false, std::memory_order_release);
+    }
+    
+    //wakes the consumer from waitForItems, and keeps it from blocking again
+    void unblock(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        _unblocked = true;
+        _cv.notify_all();
+    }
+    
+    //consumer only
+    bool isEmpty(){
+        return (_cache.isEmpty() && _tail.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) == nullptr);
+    }
+    
 private:
+    //an item placed in the cache while older items are still in the list
+    //would be dequeued ahead of them
+    template <typename... U>
+    inline bool fastEmplace(U&&... args){
+        if (_listSize.load(std::memory_order_acquire) != 0) return false;
+        if (_cache.emplace(std::forward<U>(args)...)){    
+            if (waitingReader.load(std::memory_order_acquire)) _cv.notify_one();
+            return true;
+        }
+        return false;
+    }
+    
     inline bool slowDequeue(T &output){
         listNode* tail = _tail.load(std::memory_order_relaxed);
         listNode* next = tail->next.load(std::memory_order_acquire);
         if (next == nullptr) return false;
+        //a producer which was still writing to the cache when dequeue found it
+        //empty may have since moved on to the list. Its cache item is older,
+        //and the cache claim is visible now that its list item is
+        if (!_cache.isEmpty()) return false;
 
-        output = next->data;
+        output = std::move(*next->item());
+        next->item()->~T();
         _tail.store(next, std::memory_order_release);
+        _listSize.fetch_sub(1, std::memory_order_release);
         delete tail;
         return true;
     }
     
-    inline void slowEnqueue(const T& input){
-        listNode* node = new listNode();
-        node->data = input;
+    template <typename... U>
+    inline void slowEmplace(U&&... args){
+        listNode* node = new listNode;
+        try{
+            new (node->item()) T(std::forward<U>(args)...);
+        }
+        catch (...){
+            delete node;
+            throw;
+        }
+        _listSize.fetch_add(1, std::memory_order_relaxed);
         listNode* prev_head = _head.exchange(node, std::memory_order_acq_rel);
         prev_head->next.store(node, std::memory_order_release);
 
         if (waitingReader.load(std::memory_order_acquire)) _cv.notify_one();
     }
     
+    //the data of the stub node (_tail) is always destroyed/unconstructed
     struct listNode{
-        T                           data;
+        alignas(T) unsigned char    data[sizeof(T)];
         std::atomic<listNode*> next{nullptr};
+        
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
     };
     
     ContiguousMPMCQueue<T, CACHE_SIZE> _cache;
     std::atomic<listNode*> _head{new listNode};
     std::atomic<listNode*> _tail{_head.load(std::memory_order_relaxed)};
+    //number of items linked into the list (incremented before linking)
+    std::atomic<size_t> _listSize{0};
     std::mutex _mutex;
     std::condition_variable _cv;
     std::atomic<bool> waitingReader{false};
+    bool _unblocked{false};
     
     MPSCQueue(const MPSCQueue&) {}
     void operator=(const MPSCQueue&) {}
@@ -0,0 +1,54 @@
+/*
+ * File:   MappedFile.h
+ * Author: Barath Kannan
+ * A regular file mapped into memory (shared, so writes reach the page cache
+ * without any write calls). Files created for writing are sized up front
+ * (sparsely, so unused space costs nothing), and can be truncated to the
+ * length actually used once writing has finished.
+ * Created on 20 October 2026, 3:30 AM
+ */
+
+#ifndef BSIGNALS_MAPPEDFILE_H
+#define BSIGNALS_MAPPEDFILE_H
+
+#include <string>
+#include <cstdint>
+
+namespace BSignals{ namespace details{
+
+class MappedFile{
+public:
+    //creates (or truncates) path, sized and mapped read/write to size bytes
+    //throws std::system_error on failure
+    MappedFile(const std::string& path, size_t size);
+
+    //maps an existing file read only
+    //throws std::system_error on failure
+    explicit MappedFile(const std::string& path);
+
+    //unmaps, truncating the file to the length given to setLength (if any)
+    ~MappedFile();
+
+    void* getData() const;
+    size_t getSize() const;
+
+    //length the file is truncated to when unmapped (writable files only)
+    void setLength(size_t length);
+
+    //writes dirty pages back to the file, blocking until done
+    void sync();
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+    int fd{-1};
+    void* data{nullptr};
+    size_t size{0};
+    size_t length{0};
+    bool writable{false};
+};
+
+}}
+
+#endif /* BSIGNALS_MAPPEDFILE_H */
@@ -0,0 +1,260 @@
+/*
+ * File:   SPSCQueue.hpp
+ * Author: Barath Kannan
+ * Wait-free single producer single consumer ring buffer.
+ * The producer and consumer each keep a cached copy of the other's index
+ * so the shared index is only re-read when the ring looks full/empty.
+ * Can also be used as a blocking queue (on the consumer side). An enqueue on
+ * a full ring goes to an unbounded linked list instead, and the producer
+ * keeps to the list until the consumer has drained it, so that items are
+ * always dequeued in the order they were enqueued.
+ * Only one thread may ever enqueue, which is asserted in debug builds.
+ * The producer doesn't fence after publishing an item: it only checks
+ * whether the consumer is asleep, so a consumer which announces itself just
+ * as an item is published can miss it. The consumer spins before it
+ * announces itself, and its first sleep is timed to cover that race.
+ * Created on 19 October 2026, 1:10 PM
+ */
+
+#ifndef BSIGNALS_SPSCQUEUE_HPP
+#define BSIGNALS_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <cassert>
+
+namespace BSignals{ namespace details{
+
+template<typename T, size_t N=1024>
+class SPSCQueue{
+public:
+
+    SPSCQueue(){
+        static_assert((N != 0) && ((N & (~N + 1)) == N), "size of SPSC queue must be power of 2");
+    }
+
+    ~SPSCQueue(){
+        size_t head = _head.load(std::memory_order_relaxed);
+        for (size_t i=_tail.load(std::memory_order_relaxed); i!=head; ++i){
+            _buffer[i & (N-1)].item()->~T();
+        }
+        listNode* tail = _overflowTail;
+        while (listNode* next = tail->next.load(std::memory_order_relaxed)){
+            next->item()->~T();
+            delete tail;
+            tail = next;
+        }
+        delete tail;
+    }
+
+    void enqueue(const T& input){
+        emplace(input);
+    }
+
+    void enqueue(T&& input){
+        emplace(std::move(input));
+    }
+
+    //never waits, items go to the overflow list while the ring is full
+    template <typename... U>
+    void emplace(U&&... args){
+        if (tryEmplace(std::forward<U>(args)...)) return;
+        listNode* node = new listNode;
+        try{
+            new (node->item()) T(std::forward<U>(args)...);
+        }
+        catch(...){
+            delete node;
+            throw;
+        }
+        //counted before it's published, so the consumer never takes the
+        //count below zero
+        _overflowSize.fetch_add(1, std::memory_order_relaxed);
+        _overflowHead->next.store(node, std::memory_order_release);
+        _overflowHead = node;
+        notifyReader();
+    }
+
+    //the item is only constructed from args if there is room in the ring, and
+    //the overflow list is empty
+    template <typename... U>
+    bool tryEmplace(U&&... args){
+        assertProducer();
+        //once the consumer has taken the last overflow item, the ring is
+        //empty, as nothing is put in the ring while the list holds items
+        if (_overflowSize.load(std::memory_order_acquire) != 0) return false;
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _cachedTail == N){
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head - _cachedTail == N) return false;
+        }
+        new (_buffer[head & (N-1)].item()) T(std::forward<U>(args)...);
+        _head.store(head + 1, std::memory_order_release);
+
+        notifyReader();
+        return true;
+    }
+
+    bool dequeue(T& output){
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _cachedHead){
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail == _cachedHead) return dequeueOverflow([&output](T&& item){output = std::move(item);});
+        }
+        T* item = _buffer[tail & (N-1)].item();
+        output = std::move(*item);
+        item->~T();
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //dequeue up to maxItems, invoking func with each (as an rvalue)
+    //the head is read once; each item is moved out and its cell handed back
+    //to the producer before func is invoked, since the producer waits on a
+    //full ring
+    //returns the number of items dequeued
+    template <typename F>
+    size_t bulkDequeue(F&& func, size_t maxItems = SIZE_MAX){
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        _cachedHead = _head.load(std::memory_order_acquire);
+        size_t count = std::min<size_t>(_cachedHead - tail, maxItems);
+        for (size_t i=0; i<count; ++i){
+            T* cell = _buffer[(tail + i) & (N-1)].item();
+            T item(std::move(*cell));
+            cell->~T();
+            _tail.store(tail + i + 1, std::memory_order_release);
+            func(std::move(item));
+        }
+        if (count == _cachedHead - tail){
+            while (count < maxItems && dequeueOverflow(func)) ++count;
+        }
+        return count;
+    }
+
+    void blockingDequeue(T& output){
+        waitUntil([&](){return dequeue(output);});
+    }
+
+    //blocks until the queue holds an item or unblock has been called, so
+    //that a consumer can wait without an item to dequeue into
+    void waitForItems(){
+        waitUntil([this](){
+            return (_head.load(std::memory_order_acquire) != _tail.load(std::memory_order_relaxed) ||
+                _overflowTail->next.load(std::memory_order_acquire) != nullptr || _unblocked.load(std::memory_order_relaxed));
+        });
+    }
+
+    //wakes the consumer from waitForItems, and keeps it from blocking again
+    void unblock(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        _unblocked.store(true, std::memory_order_relaxed);
+        _cv.notify_all();
+    }
+
+private:
+    struct listNode{
+        alignas(T) unsigned char data[sizeof(T)];
+        std::atomic<listNode*> next{nullptr};
+
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
+    };
+
+    //takes the oldest overflow item, unless the ring holds items (which were
+    //all enqueued before it)
+    template <typename F>
+    bool dequeueOverflow(F&& func){
+        listNode* next = _overflowTail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        if (_head.load(std::memory_order_acquire) != _tail.load(std::memory_order_relaxed)) return false;
+        delete _overflowTail;
+        _overflowTail = next;
+        T item(std::move(*next->item()));
+        next->item()->~T();
+        _overflowSize.fetch_sub(1, std::memory_order_release);
+        func(std::move(item));
+        return true;
+    }
+
+    //no StoreLoad fence on the fast path, see waitUntil
+    void notifyReader(){
+        if (waitingReader.load(std::memory_order_relaxed)){
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cv.notify_one();
+        }
+    }
+
+    void assertProducer(){
+#ifndef NDEBUG
+        std::thread::id self = std::this_thread::get_id();
+        std::thread::id expected;
+        if (!_producer.compare_exchange_strong(expected, self, std::memory_order_relaxed)){
+            assert(expected == self && "SPSCQueue: enqueued from more than one thread");
+        }
+#endif
+    }
+
+    //an item published as the reader sets waitingReader can go unnoticed by
+    //both, so the first sleep is timed; items published after that see
+    //waitingReader and notify
+    template <typename P>
+    void waitUntil(P&& ready){
+        for (uint32_t i=0; i<64; ++i){
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        waitingReader.store(true, std::memory_order_relaxed);
+        if (!ready() && !_cv.wait_for(lock, std::chrono::milliseconds(1), ready)){
+            while (!ready()){
+                _cv.wait(lock);
+            }
+        }
+        waitingReader.store(false, std::memory_order_relaxed);
+    }
+
+    struct cell_t{
+        alignas(T) unsigned char data[sizeof(T)];
+
+        T* item(){
+            return reinterpret_cast<T*>(data);
+        }
+    };
+
+    std::array<cell_t, N> _buffer;
+    char pad0[64];
+    //producer
+    std::atomic<size_t> _head{0};
+    size_t _cachedTail{0};
+    listNode* _overflowHead{new listNode};
+#ifndef NDEBUG
+    std::atomic<std::thread::id> _producer{std::thread::id()};
+#endif
+    char pad1[64];
+    //consumer
+    std::atomic<size_t> _tail{0};
+    size_t _cachedHead{0};
+    listNode* _overflowTail{_overflowHead};
+    char pad2[64];
+    //items in the overflow list
+    std::atomic<size_t> _overflowSize{0};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::atomic<bool> waitingReader{false};
+    std::atomic<bool> _unblocked{false};
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    void operator=(const SPSCQueue&) = delete;
+};
+}}
+
+#endif /* BSIGNALS_SPSCQUEUE_HPP */
@@ -0,0 +1,57 @@
+/*
+ * File:   SharedMemoryRegion.h
+ * Author: Barath Kannan
+ * A named POSIX shared memory object (shm_open) mapped into this process.
+ * The creating side owns the name, and unlinks it on destruction, while
+ * other processes open the existing object by name. Also wraps the futex
+ * calls used to wait on words in shared memory across processes.
+ * Created on 20 October 2026, 2:10 AM
+ */
+
+#ifndef BSIGNALS_SHAREDMEMORYREGION_H
+#define BSIGNALS_SHAREDMEMORYREGION_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+namespace BSignals{ namespace details{
+
+class SharedMemoryRegion{
+public:
+    //creates a zero filled object of size bytes, replacing any existing
+    //object with the same name (which processes that have it open keep)
+    //throws std::system_error on failure
+    SharedMemoryRegion(const std::string& name, size_t size);
+
+    //opens an existing object, mapping all of it
+    //throws std::system_error on failure
+    explicit SharedMemoryRegion(const std::string& name);
+
+    ~SharedMemoryRegion();
+
+    void* getData() const;
+    size_t getSize() const;
+
+private:
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    void operator=(const SharedMemoryRegion&) = delete;
+
+    void map(int fd);
+
+    std::string name;
+    void* data{nullptr};
+    size_t size{0};
+    bool owner{false};
+};
+
+//blocks while word holds expected (returning spuriously at times), until
+//woken by futexWake from any process mapping the word
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected);
+
+//wakes up to count waiters on word
+void futexWake(std::atomic<uint32_t>& word, int count);
+
+}}
+
+#endif /* BSIGNALS_SHAREDMEMORYREGION_H */
@@ -0,0 +1,180 @@
+/*
+ * File:   SharedMemoryRing.hpp
+ * Author: Barath Kannan
+ * Bounded multi producer, single consumer ring laid out in caller provided
+ * (shared) memory, so producers in several processes can feed a consumer in
+ * another. Cells follow Vyukov's bounded MPMC algorithm, as in
+ * ContiguousMPMCQueue. An idle consumer sleeps on a futex, which producers
+ * only wake (with a syscall) when the consumer has announced it is sleeping.
+ * T must be trivially copyable, as it is shared by address spaces which know
+ * nothing of each other, and provide a static getSignature() summarizing
+ * its type (as TrivialEmission does), which attaching processes must match.
+ * Created on 20 October 2026, 2:25 AM
+ */
+
+#ifndef BSIGNALS_SHAREDMEMORYRING_HPP
+#define BSIGNALS_SHAREDMEMORYRING_HPP
+
+#include <atomic>
+#include <new>
+#include <utility>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "BSignals/details/SharedMemoryRegion.h"
+
+namespace BSignals{ namespace details{
+
+template <typename T>
+class SharedMemoryRing{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "shared memory ring items must be trivially copyable");
+
+    //bytes of memory needed for a ring of capacity items
+    static size_t getRequiredSize(uint32_t capacity){
+        return sizeof(Header) + (size_t)capacity*sizeof(Cell);
+    }
+
+    //initializes a ring in memory of at least getRequiredSize(capacity) bytes
+    //capacity must be a power of 2
+    static SharedMemoryRing create(void* memory, uint32_t capacity){
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0){
+            throw std::invalid_argument("SharedMemoryRing: capacity must be a power of 2");
+        }
+        Header* header = new (memory) Header;
+        header->signature = T::getSignature();
+        header->cellSize = sizeof(Cell);
+        header->capacity = capacity;
+        Cell* cells = reinterpret_cast<Cell*>(header + 1);
+        for (uint32_t i=0; i<capacity; ++i){
+            new (&cells[i]) Cell;
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        //published last, so an attaching process never sees a partial ring
+        header->magic.store(ringMagic, std::memory_order_release);
+        return SharedMemoryRing(header);
+    }
+
+    //attaches to a ring created (for the same T) in size bytes of memory
+    //throws std::invalid_argument if the memory does not hold such a ring
+    static SharedMemoryRing attach(void* memory, size_t size){
+        Header* header = static_cast<Header*>(memory);
+        if (size < sizeof(Header) || header->magic.load(std::memory_order_acquire) != ringMagic){
+            throw std::invalid_argument("SharedMemoryRing: memory does not hold an initialized ring");
+        }
+        if (header->signature != T::getSignature() || header->cellSize != sizeof(Cell) ||
+                size < getRequiredSize(header->capacity)){
+            throw std::invalid_argument("SharedMemoryRing: ring was created for a different item type");
+        }
+        return SharedMemoryRing(header);
+    }
+
+    //returns false (without constructing an item) if the ring is full
+    template <typename... U>
+    bool tryEmplace(U&&... args){
+        uint64_t head = header->head.load(std::memory_order_relaxed);
+        for (;;){
+            Cell& cell = cells[head & mask];
+            uint64_t seq = cell.seq.load(std::memory_order_acquire);
+            int64_t dif = (int64_t)seq - (int64_t)head;
+            if (dif == 0){
+                if (header->head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)){
+                    new (cell.item()) T(std::forward<U>(args)...);
+                    cell.seq.store(head + 1, std::memory_order_release);
+                    break;
+                }
+            }
+            else if (dif < 0){
+                return false;
+            }
+            else{
+                head = header->head.load(std::memory_order_relaxed);
+            }
+        }
+        //pairs with the fence in wait, either the consumer sees the item or
+        //the producer sees the consumer sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header->sleeping.load(std::memory_order_relaxed)) wake();
+        return true;
+    }
+
+    //calls f with a reference to the oldest item in place, then frees its
+    //cell, returns false if there is no item ready
+    //must only be called by the consumer
+    template <typename F>
+    bool consume(F&& f){
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        Cell& cell = cells[tail & mask];
+        if (cell.seq.load(std::memory_order_acquire) != tail + 1) return false;
+        f(*cell.item());
+        header->tail.store(tail + 1, std::memory_order_relaxed);
+        cell.seq.store(tail + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    //blocks the consumer until an item may be ready, or interrupt is called
+    //shouldWait is checked after the consumer has announced itself, so a
+    //flag set before interrupt is always seen
+    template <typename F>
+    void wait(F&& shouldWait){
+        uint32_t sequence = header->wakeSequence.load(std::memory_order_acquire);
+        header->sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isEmpty() && shouldWait()) futexWait(header->wakeSequence, sequence);
+        header->sleeping.store(0, std::memory_order_relaxed);
+    }
+
+    //wakes the consumer from wait
+    void interrupt(){
+        wake();
+    }
+
+    uint32_t getCapacity() const{
+        return mask + 1;
+    }
+
+private:
+    static const uint64_t ringMagic{0x42534947524e4731ULL};
+
+    struct Header{
+        std::atomic<uint64_t> magic{0};
+        uint64_t signature{0};
+        uint32_t cellSize{0};
+        uint32_t capacity{0};
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        alignas(64) std::atomic<uint32_t> wakeSequence{0};
+        std::atomic<uint32_t> sleeping{0};
+    };
+
+    struct Cell{
+        T* item(){
+            return reinterpret_cast<T*>(&storage);
+        }
+
+        std::atomic<uint64_t> seq{0};
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    SharedMemoryRing(Header* h)
+    : header(h), cells(reinterpret_cast<Cell*>(h + 1)), mask(h->capacity - 1){}
+
+    bool isEmpty() const{
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        return (cells[tail & mask].seq.load(std::memory_order_acquire) != tail + 1);
+    }
+
+    void wake(){
+        header->wakeSequence.fetch_add(1, std::memory_order_release);
+        futexWake(header->wakeSequence, INT_MAX);
+    }
+
+    Header* header;
+    Cell* cells;
+    uint32_t mask;
+};
+
+}}
+
+#endif /* BSIGNALS_SHAREDMEMORYRING_HPP */
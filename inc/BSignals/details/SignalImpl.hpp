@@ -10,6 +10,8 @@
 
 #include <functional>
 #include <map>
+#include <algorithm>
+#include <vector>
 #include <unordered_map>
 #include <atomic>
 #include <mutex>
@@ -17,8 +19,14 @@
 #include <thread>
 #include <utility>
 #include <type_traits>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <exception>
+#include <stdexcept>
 
 #include "BSignals/ExecutorScheme.h"
+#include "BSignals/CompletionHandle.h"
 #include "BSignals/details/MPSCQueue.hpp"
 #include "BSignals/details/WheeledThreadPool.h"
 #include "BSignals/details/Semaphore.h"
@@ -28,19 +36,24 @@
 #include "BSignals/details/ThreadPooledSlot.hpp"
 #include "BSignals/details/AsynchronousSlot.hpp"
 #include "BSignals/details/DeferredSlot.hpp"
+#include "BSignals/details/BufferedDeferredSlot.hpp"
+#include "BSignals/details/ExecutorSlot.hpp"
+#include "BSignals/details/KeyedStrandSlot.hpp"
 #include "BSignals/details/SynchronousSlot.hpp"
+#include "BSignals/Instrumentation.h"
 
 namespace BSignals{ namespace details{
 
-template <typename... Args>
-class SignalImpl {
+//Policy provides the instrumentation hooks (see BSignals/Instrumentation.h)
+template <typename Policy, typename... Args>
+class BasicSignalImpl {
 public:
-    SignalImpl() = default;
+    BasicSignalImpl() = default;
     
-    SignalImpl(bool enforceThreadSafety) 
+    BasicSignalImpl(bool enforceThreadSafety) 
         : enableEmissionGuard{enforceThreadSafety} {}
         
-    ~SignalImpl(){
+    ~BasicSignalImpl(){
         disconnectAllSlots();
     }
 
@@ -55,11 +68,24 @@ public:
         return connectSlot(scheme, boundFunc);
     }
     
+    template<typename Executor, typename F, typename C, typename = typename std::enable_if<IsExecutor<Executor>::value>::type>
+    int connectMemberSlot(Executor& executor, F&& function, C&& instance){
+        static_assert(std::is_member_function_pointer<F>::value, "function is not a member function");
+        static_assert(std::is_object<std::remove_reference<C>>::value, "instance is not a class object");
+        
+        auto boundFunc = objectBind(function, instance);
+        return connectSlot(executor, boundFunc);
+    }
+    
     int connectSlot(BSignals::ExecutorScheme scheme, std::function<void(Args...)> slot){
+        if (scheme == ExecutorScheme::KEYED_STRAND && !IsFirstArgumentHashable<Args...>::value){
+            throw std::invalid_argument("Signal: KEYED_STRAND needs a first argument hashable with std::hash, use connectKeyedSlot");
+        }
         uint32_t id = currentId.fetch_add(1);
+        if (metricsEnabled.load(std::memory_order_relaxed)) slot = instrumentSlot(id, scheme, slot);
         if (enableEmissionGuard){
             std::lock_guard<std::mutex> lock(connectBufferLock);
-            connectBuffer.emplace(id, ConnectDescriptor{scheme, slot});
+            connectBuffer.emplace(id, ConnectDescriptor{scheme, slot, nullptr});
             connectBufferDirty = true;
             return id;
         }
@@ -68,12 +94,32 @@ public:
         }
     }
     
+    //emissions are handed to executor.dispatch (or executor.post)
+    //the executor must outlive the connection
+    template<typename Executor, typename = typename std::enable_if<IsExecutor<Executor>::value>::type>
+    int connectSlot(Executor& executor, std::function<void(Args...)> slot){
+        uint32_t id = currentId.fetch_add(1);
+        std::unique_ptr<Slot<Args...>> slotInstance = std::make_unique<ExecutorSlot<Executor, Args...>>(slot, executor);
+        if (enableEmissionGuard){
+            std::lock_guard<std::mutex> lock(connectBufferLock);
+            connectBuffer.emplace(id, ConnectDescriptor{ExecutorScheme::SYNCHRONOUS, nullptr, std::move(slotInstance)});
+            connectBufferDirty = true;
+            return id;
+        }
+        else{
+            return insertSlot(id, std::move(slotInstance));
+        }
+    }
+    
     void disconnectSlot(int id){
+        if (metricsEnabled.load(std::memory_order_relaxed)){
+            std::lock_guard<std::mutex> lock(metricsLock);
+            slotMetrics.erase((uint32_t)id);
+        }
         if (enableEmissionGuard){
             slotLock.lock_shared();
-            auto it = slots.find(id);
-            if (it == slots.end()) return;
-            it->second->markForDeath();
+            Slot<Args...>* slot = findSlot(id);
+            if (slot) slot->markForDeath();
             slotLock.unlock_shared();
         }
         else{
@@ -84,50 +130,360 @@ public:
     void disconnectAllSlots(){
         slotLock.lock();
         slots.clear();
+        bufferedSlots.clear();
+        parallelSlots.clear();
+        parallelList.clear();
         slotLock.unlock();
+        std::lock_guard<std::mutex> lock(metricsLock);
+        slotMetrics.clear();
     }
     
     void emitSignal(const Args& ... p){
+        auto context = instrumentation.beginEmit();
         enableEmissionGuard ? emitSignalThreadSafe(p...) : emitSignalUnsafe(p...);
+        instrumentation.endEmit(context);
     }
     
-    void invokeDeferred(){
-        slotLock.lock_shared();
-        std::pair<std::function<void()>, uint32_t> deferredInvocation;
-        if (!deferredQueue) return;
-        while (deferredQueue->dequeue(deferredInvocation)){
-            if (!enableEmissionGuard || getIsStillConnectedFromExecutor(deferredInvocation.second)){
-                deferredInvocation.first();
-            }
+    //connect slot with the KEYED_STRAND scheme, using keyFunction to pick the
+    //lane for each emission
+    int connectKeyedSlot(std::function<size_t(const Args&...)> keyFunction, std::function<void(Args...)> slot){
+        if (!keyFunction) throw std::invalid_argument("Signal: connectKeyedSlot needs a key function");
+        uint32_t id = currentId.fetch_add(1);
+        if (metricsEnabled.load(std::memory_order_relaxed)) slot = instrumentSlot(id, ExecutorScheme::KEYED_STRAND, slot);
+        std::unique_ptr<Slot<Args...>> slotInstance = makeSlot<KeyedStrandSlot<Args...>, InstrumentedKeyedStrandSlot<Args...>>(id, slot, keyFunction);
+        if (enableEmissionGuard){
+            std::lock_guard<std::mutex> lock(connectBufferLock);
+            connectBuffer.emplace(id, ConnectDescriptor{ExecutorScheme::KEYED_STRAND, nullptr, std::move(slotInstance)});
+            connectBufferDirty = true;
+            return id;
         }
-        slotLock.unlock_shared();
+        else{
+            return insertSlot(id, std::move(slotInstance));
+        }
+    }
+    
+    typedef std::pair<uint32_t, Slot<Args...>*> ResolvedSlot;
+    
+    //slots found with resolveSlot stay valid until unlockSlots (connections
+    //made since the last emission are applied first, so they can be found)
+    void lockSlots(){
+        if (enableEmissionGuard){
+            applyConnectBuffer();
+            slotLock.lock_shared();
+        }
+    }
+    
+    void unlockSlots(){
+        if (enableEmissionGuard) slotLock.unlock_shared();
+    }
+    
+    //the slot with id, or nullptr if it isn't connected (yet)
+    //slots must be locked with lockSlots
+    Slot<Args...>* resolveSlot(uint32_t id) const{
+        return findSlot(id);
+    }
+    
+    //emit to only the given slots, which must be locked with lockSlots
+    void emitSignalTo(const ResolvedSlot* begin, const ResolvedSlot* end, const Args& ... p){
+        auto context = instrumentation.beginEmit();
+        for (; begin != end; ++begin){
+            if (begin->second->isAlive()) dispatch(begin->first, begin->second, p...);
+        }
+        instrumentation.endEmit(context);
+    }
+    
+    //emit, returning a handle which completes once every slot connected at the
+    //time of emission has processed (or discarded) it
+    CompletionHandle emitAsync(const Args& ... p){
+        auto context = instrumentation.beginEmit();
+        CompletionState* state = CompletionState::acquire();
+        if (enableEmissionGuard){
+            applyConnectBuffer();
+            slotLock.lock_shared();
+            emitTracked(state, p...);
+            slotLock.unlock_shared();
+        }
+        else{
+            emitTracked(state, p...);
+        }
+        instrumentation.endEmit(context);
+        //drop the emitter's count, completing if every slot was synchronous
+        state->countDown();
+        return CompletionHandle(state);
+    }
+    
+    void invokeDeferred(){
+        invokeDeferredUntil(UINT32_MAX, [](){return false;});
+    }
+    
+    //invoke at most maxItems deferred emissions
+    //returns the number of deferred emissions still queued
+    uint32_t invokeDeferred(uint32_t maxItems){
+        return invokeDeferredUntil(maxItems, [](){return false;});
+    }
+    
+    //invoke deferred emissions until the queue is empty or timeBudget has elapsed
+    //the budget is checked before each invocation, so a single long slot can overrun it
+    //returns the number of deferred emissions still queued
+    template <typename Rep, typename Period>
+    uint32_t invokeDeferred(std::chrono::duration<Rep, Period> timeBudget){
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeBudget);
+        return invokeDeferredUntil(UINT32_MAX, [deadline](){return std::chrono::steady_clock::now() >= deadline;});
     }
     
     void operator()(const Args &... p){
         emitSignal(p...);
     }
     
+    Policy& getInstrumentation(){
+        return instrumentation;
+    }
+    
+    //slots connected from now on (other than to custom executors) record
+    //execution time, and strand slots their queue depth and sojourn time
+    void enableMetrics(){
+        metricsEnabled.store(true, std::memory_order_relaxed);
+    }
+    
+    //snapshot of the metrics of every connected, instrumented slot
+    std::vector<SlotMetricsSnapshot> getMetrics() const{
+        std::vector<SlotMetricsSnapshot> snapshots;
+        std::lock_guard<std::mutex> lock(metricsLock);
+        for (auto const &kvpair : slotMetrics){
+            snapshots.push_back(kvpair.second->snapshot());
+        }
+        return snapshots;
+    }
+    
 private:
-    SignalImpl<Args...>(const SignalImpl<Args...>& that) = delete;
-    void operator=(const SignalImpl<Args...>&) = delete;
+    BasicSignalImpl(const BasicSignalImpl& that) = delete;
+    void operator=(const BasicSignalImpl&) = delete;
+    
+    //executes slot, between the policy's dispatch hooks
+    inline void dispatch(uint32_t id, Slot<Args...>* slot, const Args& ... p){
+        auto context = instrumentation.beginDispatch(id);
+        slot->execute(p...);
+        instrumentation.endDispatch(id, context);
+    }
     
     inline void disconnectSlotFunction(uint32_t id){
         slotLock.lock();
         auto it = slots.find(id);
-        if (it == slots.end()) return;
-        slots.erase(it);
+        if (it != slots.end()) eraseSlot(it);
+        else if (parallelSlots.erase(id)) rebuildParallelList();
         slotLock.unlock();
     }
     
+    //registers metrics for the slot, and wraps it to time its execution
+    std::function<void(Args...)> instrumentSlot(uint32_t id, ExecutorScheme scheme, std::function<void(Args...)> slot){
+        auto metrics = std::make_shared<SlotMetrics>((int)id, scheme);
+        {
+            std::lock_guard<std::mutex> lock(metricsLock);
+            slotMetrics.emplace(id, metrics);
+        }
+        return [slot, metrics](Args... p){
+            uint64_t start = getMetricsTimestamp();
+            slot(std::forward<Args>(p)...);
+            metrics->executionTime.record(getMetricsTimestamp() - start);
+        };
+    }
+    
+    //the instrumented variant of a slot is only constructed if it has metrics,
+    //or the policy traces slots, so uninstrumented slots carry no checks
+    template <typename Plain, typename Instrumented, typename... CtorArgs>
+    std::unique_ptr<Slot<Args...>> makeSlot(uint32_t id, CtorArgs&&... ctorArgs){
+        auto metrics = findMetrics(id);
+        if (!metrics && !TracesSlots<Policy>::value) return std::make_unique<Plain>(std::forward<CtorArgs>(ctorArgs)...);
+        std::unique_ptr<Slot<Args...>> slotInstance = std::make_unique<Instrumented>(std::forward<CtorArgs>(ctorArgs)...);
+        slotInstance->setId(id);
+        if (metrics) slotInstance->setMetrics(std::move(metrics));
+        return slotInstance;
+    }
+    
+    std::unique_ptr<Slot<Args...>> makeKeyedStrandSlot(uint32_t id, std::function<void(Args...)> slot, std::true_type){
+        return makeSlot<KeyedStrandSlot<Args...>, InstrumentedKeyedStrandSlot<Args...>>(id, slot);
+    }
+    
+    //never called, connectSlot rejects KEYED_STRAND without a hashable first argument
+    std::unique_ptr<Slot<Args...>> makeKeyedStrandSlot(uint32_t, std::function<void(Args...)>, std::false_type){
+        return nullptr;
+    }
+    
+    inline std::shared_ptr<SlotMetrics> findMetrics(uint32_t id) const{
+        if (!metricsEnabled.load(std::memory_order_relaxed)) return nullptr;
+        std::lock_guard<std::mutex> lock(metricsLock);
+        auto it = slotMetrics.find(id);
+        return (it != slotMetrics.end() ? it->second : nullptr);
+    }
+    
+    //slotLock must already be held
+    inline Slot<Args...>* findSlot(uint32_t id) const{
+        auto it = slots.find(id);
+        if (it != slots.end()) return it->second.get();
+        auto parallelIt = parallelSlots.find(id);
+        return (parallelIt != parallelSlots.end() ? parallelIt->second.get() : nullptr);
+    }
+    
+    //slotLock must already be held exclusively
+    inline void rebuildParallelList(){
+        parallelList.clear();
+        for (auto const &kvpair : parallelSlots){
+            parallelList.emplace_back(kvpair.first, kvpair.second.get());
+        }
+    }
+    
+    //executes the parallel synchronous slots, split into chunks which are
+    //claimed by the calling thread and by helper tasks on the thread pool
+    //returns once every chunk has completed. Helpers which haven't started by
+    //the time the caller runs out of chunks are never waited for, so this
+    //doesn't block on the pool (e.g. when called from a busy pool worker)
+    //slotLock must already be held (shared, if emission is guarded)
+    inline void emitParallel(const Args& ... p){
+        const size_t n = parallelList.size();
+        if (n == 0) return;
+        static const size_t maxHelpers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        const size_t nChunks = (n + parallelChunkSize - 1) / parallelChunkSize;
+        std::atomic<size_t> nextChunk{0};
+        auto work = [&](){
+            for (size_t c; (c = nextChunk.fetch_add(1, std::memory_order_relaxed)) < nChunks;){
+                size_t end = std::min(n, (c + 1) * parallelChunkSize);
+                for (size_t i = c * parallelChunkSize; i < end; ++i){
+                    if (parallelList[i].second->isAlive()) dispatch(parallelList[i].first, parallelList[i].second, p...);
+                }
+            }
+        };
+        const size_t nHelpers = std::min(nChunks - 1, maxHelpers);
+        if (nHelpers == 0){
+            work();
+            return;
+        }
+        //shared with the helpers, which may start after this has returned
+        auto join = std::make_shared<ParallelJoin>();
+        join->work = work;
+        for (size_t i=0; i<nHelpers; ++i){
+            WheeledThreadPool::run([join](){
+                join->active.fetch_add(1);
+                if (!join->closed.load()){
+                    //a throwing slot is rethrown by the emitter, rather than
+                    //escaping the pool task
+                    try{
+                        join->work();
+                    }
+                    catch(...){
+                        std::lock_guard<std::mutex> lock(join->errorLock);
+                        if (!join->error) join->error = std::current_exception();
+                    }
+                }
+                join->active.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        std::exception_ptr error;
+        try{
+            work();
+        }
+        catch(...){
+            error = std::current_exception();
+        }
+        //every chunk has been claimed (or a slot has thrown), so only helpers
+        //which have registered are waited for, and none start on this frame
+        //after it's gone. closed and active are a store-load handshake with
+        //the helpers, so both sides are seq_cst: either this sees a helper
+        //registered, or the helper sees closed and doesn't touch this frame
+        join->closed.store(true);
+        while (join->active.load() != 0){
+            std::this_thread::yield();
+        }
+        if (!error){
+            std::lock_guard<std::mutex> lock(join->errorLock);
+            error = join->error;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+    
+    //slotLock must already be held exclusively
+    inline typename std::map<uint32_t, std::unique_ptr<Slot<Args...>>>::iterator eraseSlot(typename std::map<uint32_t, std::unique_ptr<Slot<Args...>>>::iterator it){
+        bufferedSlots.erase(it->first);
+        return slots.erase(it);
+    }
+    
+    //deferred emissions are invoked in chunks, and slotLock is released
+    //between chunks so that a long drain doesn't starve connects/disconnects
+    //queued emissions are invoked before buffered emissions
+    template <typename F>
+    uint32_t invokeDeferredUntil(uint32_t maxItems, F&& expired){
+        uint32_t remaining = 0;
+        uint32_t invoked = 0;
+        if (deferredQueue){
+            invoked = invokeQueuedUntil(maxItems, expired);
+            remaining += deferredQueue->pending.load(std::memory_order_relaxed);
+        }
+        if (hasBufferedSlots.load(std::memory_order_acquire)){
+            invokeBufferedUntil(maxItems - invoked, expired);
+            slotLock.lock_shared();
+            for (auto const &kvpair : bufferedSlots){
+                remaining += kvpair.second->getPending();
+            }
+            slotLock.unlock_shared();
+        }
+        return remaining;
+    }
+    
+    template <typename F>
+    uint32_t invokeQueuedUntil(uint32_t maxItems, F&& expired){
+        DeferredQueue::Invocation deferredInvocation;
+        uint32_t invoked = 0;
+        while (invoked < maxItems){
+            uint32_t chunk = (maxItems - invoked < deferredChunkSize) ? maxItems - invoked : deferredChunkSize;
+            uint32_t n = 0;
+            slotLock.lock_shared();
+            for (; n < chunk && !expired() && deferredQueue->queue.dequeue(deferredInvocation); ++n){
+                //invocations of disconnected slots are discarded (which also
+                //releases any completion token they hold)
+                if (getIsStillConnected(deferredInvocation.second)){
+                    deferredInvocation.first();
+                }
+            }
+            slotLock.unlock_shared();
+            deferredQueue->pending.fetch_sub(n, std::memory_order_relaxed);
+            invoked += n;
+            if (n < chunk) break;
+        }
+        return invoked;
+    }
+    
+    //slots are looked up again for every chunk, as they may have been
+    //disconnected while slotLock was released
+    template <typename F>
+    uint32_t invokeBufferedUntil(uint32_t maxItems, F&& expired){
+        uint32_t invoked = 0;
+        while (invoked < maxItems){
+            uint32_t chunk = (maxItems - invoked < deferredChunkSize) ? maxItems - invoked : deferredChunkSize;
+            uint32_t n = 0;
+            slotLock.lock_shared();
+            for (auto const &kvpair : bufferedSlots){
+                if (enableEmissionGuard && !kvpair.second->isAlive()) continue;
+                n += kvpair.second->invokeBuffered(chunk - n, expired);
+                if (n == chunk) break;
+            }
+            slotLock.unlock_shared();
+            invoked += n;
+            if (n < chunk) break;
+        }
+        return invoked;
+    }
+    
     int connectSlotFunction(uint32_t id, BSignals::ExecutorScheme scheme, std::function<void(Args...)> slot){
         std::unique_ptr<Slot<Args...>> slotInstance{nullptr};
         switch(scheme){
             case(BSignals::ExecutorScheme::STRAND):
-                slotInstance = std::make_unique<StrandSlot<Args...>>(slot);
+                slotInstance = makeSlot<StrandSlot<Args...>, InstrumentedStrandSlot<Args...>>(id, slot);
+                break;
+            case(BSignals::ExecutorScheme::SINGLE_PRODUCER_STRAND):
+                slotInstance = makeSlot<SingleProducerStrandSlot<Args...>, InstrumentedSingleProducerStrandSlot<Args...>>(id, slot);
                 break;
             case(BSignals::ExecutorScheme::THREAD_POOLED):
-                if (enableEmissionGuard) slotInstance = std::make_unique<ThreadPooledSlot<Args...>>(slot, [this, id](){return getIsStillConnectedFromExecutor(id);});
-                else slotInstance = std::make_unique<ThreadPooledSlot<Args...>>(slot);
+                if (enableEmissionGuard) slotInstance = makeSlot<ThreadPooledSlot<Args...>, InstrumentedThreadPooledSlot<Args...>>(id, slot, [this, id](){return getIsStillConnectedFromExecutor(id);});
+                else slotInstance = makeSlot<ThreadPooledSlot<Args...>, InstrumentedThreadPooledSlot<Args...>>(id, slot);
                 break;
             case(BSignals::ExecutorScheme::ASYNCHRONOUS):
                 if (enableEmissionGuard) slotInstance = std::make_unique<AsynchronousSlot<Args...>>(slot, [this, id](){return getIsStillConnectedFromExecutor(id);});
@@ -137,10 +493,33 @@ private:
                 initializeDeferredQueue();
                 slotInstance = std::make_unique<DeferredSlot<Args...>>(slot, deferredQueue, id);
                 break;
+            case(BSignals::ExecutorScheme::DEFERRED_BUFFERED):{
+                auto bufferedSlot = std::make_unique<BufferedDeferredSlot<Args...>>(slot);
+                slotLock.lock();
+                bufferedSlots.emplace(id, bufferedSlot.get());
+                slots.emplace(id, std::move(bufferedSlot));
+                hasBufferedSlots.store(true, std::memory_order_release);
+                slotLock.unlock();
+                return (int)id;
+            }
+            case(BSignals::ExecutorScheme::KEYED_STRAND):
+                slotInstance = makeKeyedStrandSlot(id, slot, IsFirstArgumentHashable<Args...>());
+                break;
+            case(BSignals::ExecutorScheme::PARALLEL_SYNCHRONOUS):
+                WheeledThreadPool::startup();
+                slotLock.lock();
+                parallelSlots.emplace(id, std::make_unique<SynchronousSlot<Args...>>(slot));
+                rebuildParallelList();
+                slotLock.unlock();
+                return (int)id;
             case(BSignals::ExecutorScheme::SYNCHRONOUS):
                 slotInstance = std::make_unique<SynchronousSlot<Args...>>(slot);
                 break;
         }
+        return insertSlot(id, std::move(slotInstance));
+    }
+    
+    int insertSlot(uint32_t id, std::unique_ptr<Slot<Args...>> slotInstance){
         slotLock.lock();
         slots.emplace_hint(slots.end(), std::piecewise_construct, std::make_tuple(id),
                     std::make_tuple(std::move(slotInstance)));
@@ -149,32 +528,65 @@ private:
     }
     
     inline void initializeDeferredQueue(){
-        if (!deferredQueue) deferredQueue = std::shared_ptr<MPSCQueue<std::pair<std::function<void()>, uint32_t>>>(new MPSCQueue<std::pair<std::function<void()>, uint32_t>>);
+        if (!deferredQueue) deferredQueue = std::make_shared<DeferredQueue>();
     }
     
     inline void emitSignalUnsafe(const Args& ... p){
         for (auto const &kvpair : slots){
-            kvpair.second->execute(p...);
+            dispatch(kvpair.first, kvpair.second.get(), p...);
         }
+        emitParallel(p...);
     }
     
     inline bool getIsStillConnectedFromExecutor(uint32_t id) const{
         slotLock.lock_shared();
-        auto it = slots.find(id);
-        bool retVal = (it != slots.end() && it->second->isAlive());
+        bool retVal = getIsStillConnected(id);
         slotLock.unlock_shared();
         return retVal;
     }
     
+    //slotLock must already be held
+    inline bool getIsStillConnected(uint32_t id) const{
+        auto it = slots.find(id);
+        return (it != slots.end() && it->second->isAlive());
+    }
+    
+    inline void emitTracked(CompletionState* state, const Args& ... p){
+        for (auto const &kvpair : slots){
+            if (kvpair.second->isAlive()){
+                state->addPending();
+                auto context = instrumentation.beginDispatch(kvpair.first);
+                kvpair.second->executeTracked(CompletionToken(state), p...);
+                instrumentation.endDispatch(kvpair.first, context);
+            }
+        }
+        emitParallel(p...);
+    }
+    
     inline void emitSignalThreadSafe(const Args& ... p){
+        applyConnectBuffer();
+        slotLock.lock_shared();
+        for (auto const &kvpair : slots){
+            if (kvpair.second->isAlive()){
+                dispatch(kvpair.first, kvpair.second.get(), p...);
+            }
+        }
+        emitParallel(p...);
+        slotLock.unlock_shared();
+    }
+    
+    //moves slots connected during emission into the slot map, and erases
+    //slots which have died since
+    inline void applyConnectBuffer(){
         while (connectBufferDirty.load(std::memory_order_acquire)){
             connectBufferLock.lock();
             if (!connectBufferDirty.load(std::memory_order_acquire)){
                 connectBufferLock.unlock();
                 break;
             }
-            for (auto const &kvpair : connectBuffer){
-                connectSlotFunction(kvpair.first, kvpair.second.scheme, kvpair.second.slot);
+            for (auto &kvpair : connectBuffer){
+                if (kvpair.second.slotInstance) insertSlot(kvpair.first, std::move(kvpair.second.slotInstance));
+                else connectSlotFunction(kvpair.first, kvpair.second.scheme, kvpair.second.slot);
             }
             connectBuffer.clear();
             connectBufferDirty.store(false, std::memory_order_release);
@@ -182,21 +594,20 @@ private:
             slotLock.lock();
             for (auto it = slots.begin(); it!= slots.end();){
                 if (!it->second->isAlive()){
-                    it = slots.erase(it);
+                    it = eraseSlot(it);
                 }
                 else{
                     ++it;
                 }
             }
-            slotLock.unlock();
-        }
-        slotLock.lock_shared();
-        for (auto const &kvpair : slots){
-            if (kvpair.second->isAlive()){
-                kvpair.second->execute(p...);
+            size_t nParallel = parallelSlots.size();
+            for (auto it = parallelSlots.begin(); it != parallelSlots.end();){
+                if (!it->second->isAlive()) it = parallelSlots.erase(it);
+                else ++it;
             }
+            if (parallelSlots.size() != nParallel) rebuildParallelList();
+            slotLock.unlock();
         }
-        slotLock.unlock_shared();
     }
     
     //Reference to instance
@@ -222,11 +633,45 @@ private:
     
     //Deferred invocation queue
     //Use unique pointer so that full MPSC queue overhead is only required if there is a deferred slot
-    std::shared_ptr<MPSCQueue<std::pair<std::function<void()>, uint32_t>>> deferredQueue{nullptr};
+    std::shared_ptr<DeferredQueue> deferredQueue{nullptr};
+    
+    //Deferred slots with contiguous per-producer buffers (also owned by slots)
+    std::map<uint32_t, BufferedDeferredSlot<Args...>*> bufferedSlots;
+    std::atomic<bool> hasBufferedSlots{false};
+    
+    //Number of deferred invocations made per acquisition of slotLock
+    static const uint32_t deferredChunkSize{64};
+    
+    //Metrics of instrumented slots, by id
+    std::atomic<bool> metricsEnabled{false};
+    mutable std::mutex metricsLock;
+    std::map<uint32_t, std::shared_ptr<SlotMetrics>> slotMetrics;
+    
+    //Parallel synchronous slots, and the same slots in connection order for
+    //splitting into chunks
+    std::map<uint32_t, std::unique_ptr<Slot<Args...>>> parallelSlots;
+    std::vector<std::pair<uint32_t, Slot<Args...>*>> parallelList;
+    
+    //Number of parallel synchronous slots executed per chunk
+    static const size_t parallelChunkSize{64};
+    
+    //a helper registers in active before checking closed, and the caller
+    //closes before checking active, so either the helper sees it is closed
+    //(and leaves work untouched) or the caller waits for it
+    struct ParallelJoin{
+        std::atomic<uint32_t> active{0};
+        std::atomic<bool> closed{false};
+        std::function<void()> work;
+        //the first exception thrown by a slot on a helper
+        std::mutex errorLock;
+        std::exception_ptr error;
+    };
     
     struct ConnectDescriptor{
         ExecutorScheme scheme;
         std::function<void(Args...)> slot;
+        //set if the slot was constructed up front (scheme and slot are unused)
+        std::unique_ptr<Slot<Args...>> slotInstance;
     };
     
     mutable SharedMutex slotLock;
@@ -235,8 +680,13 @@ private:
     mutable std::mutex connectBufferLock;
     std::atomic<bool> connectBufferDirty{false};
     std::map<uint32_t, ConnectDescriptor> connectBuffer;
+    
+    Policy instrumentation;
 };
 
+template <typename... Args>
+using SignalImpl = BasicSignalImpl<BSignals::NoInstrumentation, Args...>;
+
 }}
 
 #endif /* BSIGNALS_SIGNALIMPL_HPP */
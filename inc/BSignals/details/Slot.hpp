@@ -11,10 +11,71 @@
 #include <atomic>
 #include <functional>
 #include <utility>
+#include <tuple>
+#include <type_traits>
+#include <memory>
 #include "BSignals/ExecutorScheme.h"
+#include "BSignals/details/CompletionState.h"
+#include "BSignals/details/LatencyHistogram.h"
+#include "BSignals/details/Tracer.h"
 
 namespace BSignals{ namespace details{
     
+//time of emission (for slots with metrics) and id of a traced emission,
+//only carried by the emissions of instrumented slots. The empty variant
+//adds nothing to the size of an emission, and reads as 0
+template <bool Stamped>
+struct EmissionStamp{
+    EmissionStamp() = default;
+    EmissionStamp(uint64_t, uint64_t){}
+    
+    uint64_t getEnqueueTime() const{
+        return 0;
+    }
+    
+    uint64_t getTraceId() const{
+        return 0;
+    }
+};
+
+template <>
+struct EmissionStamp<true>{
+    EmissionStamp() = default;
+    EmissionStamp(uint64_t time, uint64_t trace) : enqueueTime(time), traceId(trace){}
+    
+    uint64_t getEnqueueTime() const{
+        return enqueueTime;
+    }
+    
+    uint64_t getTraceId() const{
+        return traceId;
+    }
+    
+    uint64_t enqueueTime{0};
+    uint64_t traceId{0};
+};
+
+//emitted arguments, held by value along with the token of a tracked emission
+template <bool Stamped, typename... Args>
+struct BasicEmission : EmissionStamp<Stamped>{
+    BasicEmission() = default;
+    
+    BasicEmission(CompletionToken t, const Args& ... a)
+    : args(a...), token(std::move(t)){}
+    
+    BasicEmission(CompletionToken t, uint64_t time, uint64_t trace, const Args& ... a)
+    : EmissionStamp<Stamped>(time, trace), args(a...), token(std::move(t)){}
+    
+    std::tuple<typename std::decay<Args>::type...> args;
+    CompletionToken token;
+};
+
+template <typename... Args>
+using Emission = BasicEmission<false, Args...>;
+
+template <typename... Args>
+using InstrumentedEmission = BasicEmission<true, Args...>;
+
 template <typename... Args>
 class Slot{
 public:
@@ -22,22 +83,47 @@ public:
     virtual ~Slot(){};
     virtual void execute(const Args& ... args) = 0;
     
+    //used by emitAsync, the token must be held until the emission has been
+    //processed (or discarded). Slots which invoke synchronously can use this
+    //default, which releases the token on return
+    virtual void executeTracked(CompletionToken token, const Args& ... args){
+        execute(args...);
+    }
+    
     bool isAlive() const{
         return (alive.load(std::memory_order_acquire));
     }
     
-    void markForDeath(){
+    virtual void markForDeath(){
         alive.store(false, std::memory_order_release);
     }
     
+    //queue metrics are recorded by slots which queue emissions themselves
+    //must be set before the first emission
+    virtual void setMetrics(std::shared_ptr<SlotMetrics> m){
+        metrics = std::move(m);
+    }
+    
+    //id of the slot in its signal, recorded in trace events
+    virtual void setId(uint32_t slotId){
+        id = slotId;
+    }
+    
 protected:    
-    template<std::size_t... Is>
-    void callFuncWithTuple(const std::tuple<Args...>& tuple, std::index_sequence<Is...>) {
-        slotFunction(std::get<Is>(tuple)...);
+    //an rvalue tuple has its elements moved into the slot function
+    template<typename Tuple, std::size_t... Is>
+    void callFuncWithTuple(Tuple&& tuple, std::index_sequence<Is...>) {
+        slotFunction(std::get<Is>(std::forward<Tuple>(tuple))...);
     }
     
+    //copy of the emitted arguments which can be moved from when invoked
+    //(a lambda capture of const Args&... would capture const members)
+    typedef std::tuple<typename std::decay<Args>::type...> ArgsTuple;
+    
     std::function<void(Args...)> slotFunction;
     std::atomic<bool> alive{true};
+    std::shared_ptr<SlotMetrics> metrics;
+    uint32_t id{0};
 };
 
 }}
@@ -13,34 +13,65 @@
 #include "BSignals/details/Slot.hpp"
 #include "BSignals/details/WheeledThreadPool.h"
 #include "BSignals/details/MPSCQueue.hpp"
+#include "BSignals/details/SPSCQueue.hpp"
 
 namespace BSignals{ namespace details{
 
-template <typename... Args>
-class StrandSlot : public Slot<Args...>{
+//Queue must provide emplace, bulkDequeue, waitForItems and unblock of
+//BasicEmission<Instrumented, Args...>
+//Instrumented slots record queue metrics if they are given them (setMetrics)
+//before the first emission, and trace events for traced emissions
+template <bool Instrumented, typename Queue, typename... Args>
+class QueuedStrandSlot : public Slot<Args...>{
 public:
-    StrandSlot(std::function<void(Args...)> f) : Slot<Args...>(f){
-        strandThread = std::thread(&StrandSlot<Args...>::queueListener, this);
+    QueuedStrandSlot(std::function<void(Args...)> f) : Slot<Args...>(f){
+        strandThread = std::thread(&QueuedStrandSlot::queueListener, this);
     }
     
-    ~StrandSlot(){
-        stop = true;
-        strandQueue.enqueue(std::tuple<Args...>{});
+    ~QueuedStrandSlot(){
+        stop.store(true, std::memory_order_release);
+        strandQueue.unblock();
         strandThread.join();
     }
     
     void execute(const Args& ... args){
-        strandQueue.enqueue(std::tuple<Args...>(args...));
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    void executeTracked(CompletionToken token, const Args& ... args){
+        if (Instrumented){
+            uint64_t traceId = Tracer::getCurrentEmission();
+            if (traceId) Tracer::record(TraceEventType::ENQUEUE, traceId, this->id);
+            if (this->metrics) this->metrics->enqueued.increment();
+            strandQueue.emplace(std::move(token), this->metrics ? getMetricsTimestamp() : 0, traceId, args...);
+        }
+        else{
+            strandQueue.emplace(std::move(token), args...);
+        }
     }
     
 private:
     void queueListener(){
-        std::tuple<Args...> tuple{};
         auto maxWait = WheeledThreadPool::getMaxWait();
         std::chrono::duration<double> waitTime = std::chrono::nanoseconds(1);
-        while (!stop){
-            if (strandQueue.dequeue(tuple)){
-                if (!stop) this->callFuncWithTuple(tuple, std::index_sequence_for<Args...>());
+        auto invoke = [this](BasicEmission<Instrumented, Args...>&& e){
+            if (Instrumented && e.getEnqueueTime()){
+                this->metrics->dequeued.increment();
+                this->metrics->sojournTime.record(getMetricsTimestamp() - e.getEnqueueTime());
+            }
+            if (Instrumented && e.getTraceId()){
+                Tracer::record(TraceEventType::DEQUEUE, e.getTraceId(), this->id);
+                if (!isStopped()){
+                    Tracer::record(TraceEventType::EXECUTE_BEGIN, e.getTraceId(), this->id);
+                    this->callFuncWithTuple(std::move(e.args), std::index_sequence_for<Args...>());
+                    Tracer::record(TraceEventType::EXECUTE_END, e.getTraceId(), this->id);
+                }
+            }
+            else if (!isStopped()) this->callFuncWithTuple(std::move(e.args), std::index_sequence_for<Args...>());
+            e.token.reset();
+        };
+        while (!isStopped()){
+            if (strandQueue.bulkDequeue(invoke, batchSize)){
                 waitTime = std::chrono::nanoseconds(1);
             }
             else{
@@ -48,18 +79,37 @@ private:
                 waitTime*=2;
             }
             if (waitTime > maxWait){
-                strandQueue.blockingDequeue(tuple);
-                if (!stop) this->callFuncWithTuple(tuple, std::index_sequence_for<Args...>());
+                strandQueue.waitForItems();
                 waitTime = std::chrono::nanoseconds(1);
             }
         }
     }
 
-    MPSCQueue<std::tuple<Args...>> strandQueue;
+    bool isStopped() const{
+        return stop.load(std::memory_order_acquire);
+    }
+
+    //maximum number of emissions processed per dequeue
+    static const uint32_t batchSize{64};
+
+    Queue strandQueue;
     std::thread strandThread;
-    bool stop{false};
+    std::atomic<bool> stop{false};
 };
 
+template <typename... Args>
+using StrandSlot = QueuedStrandSlot<false, MPSCQueue<Emission<Args...>>, Args...>;
+
+template <typename... Args>
+using InstrumentedStrandSlot = QueuedStrandSlot<true, MPSCQueue<InstrumentedEmission<Args...>>, Args...>;
+
+//Emissions must not be made concurrently from more than one thread
+template <typename... Args>
+using SingleProducerStrandSlot = QueuedStrandSlot<false, SPSCQueue<Emission<Args...>>, Args...>;
+
+template <typename... Args>
+using InstrumentedSingleProducerStrandSlot = QueuedStrandSlot<true, SPSCQueue<InstrumentedEmission<Args...>>, Args...>;
+
 }}
 
 #endif /* BSIGNALS_STRANDSLOT_HPP */
@@ -13,26 +13,64 @@
 
 namespace BSignals{ namespace details{
 
-template <typename... Args>
-class ThreadPooledSlot : public Slot<Args...>{
+//Instrumented slots record trace events for traced emissions, and have their
+//tasks counted by the thread pool's metrics (if enabled)
+template <bool Instrumented, typename... Args>
+class BasicThreadPooledSlot : public Slot<Args...>{
 public:
-    ThreadPooledSlot(std::function<void(Args...)> f, std::function<bool()> validityCheck = nullptr)
+    BasicThreadPooledSlot(std::function<void(Args...)> f, std::function<bool()> validityCheck = nullptr)
     : Slot<Args...>(f), checkIfValid(validityCheck){
         WheeledThreadPool::startup();
     }
     
     void execute(const Args& ... args){
-        WheeledThreadPool::run([this, args...](){
+        executeTracked(CompletionToken(), args...);
+    }
+    
+    void executeTracked(CompletionToken token, const Args& ... args){
+        if (Instrumented){
+            uint64_t traceId = Tracer::getCurrentEmission();
+            if (traceId){
+                executeTraced(std::move(token), traceId, args...);
+                return;
+            }
+        }
+        post([this, token = std::move(token), tuple = typename Slot<Args...>::ArgsTuple(args...)]() mutable{
             if (!checkIfValid || checkIfValid()){
-                this->slotFunction(args...);
+                this->callFuncWithTuple(std::move(tuple), std::index_sequence_for<Args...>());
             }
+            token.reset();
         });
     }
     
 private:
+    void executeTraced(CompletionToken token, uint64_t traceId, const Args& ... args){
+        Tracer::record(TraceEventType::ENQUEUE, traceId, this->id);
+        post([this, token = std::move(token), traceId, tuple = typename Slot<Args...>::ArgsTuple(args...)]() mutable{
+            Tracer::record(Tracer::isRunningStolenTask() ? TraceEventType::STEAL : TraceEventType::DEQUEUE, traceId, this->id);
+            if (!checkIfValid || checkIfValid()){
+                Tracer::record(TraceEventType::EXECUTE_BEGIN, traceId, this->id);
+                this->callFuncWithTuple(std::move(tuple), std::index_sequence_for<Args...>());
+                Tracer::record(TraceEventType::EXECUTE_END, traceId, this->id);
+            }
+            token.reset();
+        });
+    }
+
+    static void post(std::function<void()> task){
+        if (Instrumented) WheeledThreadPool::runCounted(std::move(task));
+        else WheeledThreadPool::run(std::move(task));
+    }
+
     std::function<bool()> checkIfValid;
 };
 
+template <typename... Args>
+using ThreadPooledSlot = BasicThreadPooledSlot<false, Args...>;
+
+template <typename... Args>
+using InstrumentedThreadPooledSlot = BasicThreadPooledSlot<true, Args...>;
+
 }}
 
 #endif /* BSIGNALS_THREADPOOLEDSLOT_HPP */
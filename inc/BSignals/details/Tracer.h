@@ -0,0 +1,163 @@
+/*
+ * File:   Tracer.h
+ * Author: Barath Kannan
+ * Trace events, recorded into a ring buffer per thread. A thread only ever
+ * writes to its own ring, so recording takes no locks or read-modify-writes,
+ * and a full ring overwrites its oldest events. The events of an emission
+ * carry its emission id, which links the emitting thread's events to those
+ * of the threads its slots execute on.
+ * Created on 20 October 2026, 6:20 AM
+ */
+
+#ifndef BSIGNALS_TRACER_H
+#define BSIGNALS_TRACER_H
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "BSignals/details/LatencyHistogram.h"
+
+namespace BSignals{ namespace details{
+
+enum class TraceEventType : uint32_t{
+    EMIT_BEGIN,
+    EMIT_END,
+    //slot is executed, or its emission queued, by the emitting thread
+    DISPATCH_BEGIN,
+    DISPATCH_END,
+    //emission is queued for another thread
+    ENQUEUE,
+    //queued emission is taken by the thread executing it (STEAL if the
+    //thread pool task holding it was taken from another worker's spoke)
+    DEQUEUE,
+    STEAL,
+    //slot is executed by the thread which dequeued the emission
+    EXECUTE_BEGIN,
+    EXECUTE_END
+};
+
+struct TraceEvent{
+    uint64_t timestamp;
+    uint64_t emissionId;
+    uint32_t slotId;
+    TraceEventType type;
+};
+
+//events of one thread, oldest first
+struct ThreadTrace{
+    uint32_t thread;
+    std::vector<TraceEvent> events;
+};
+
+class TraceRing{
+public:
+    //capacity must be a power of 2
+    TraceRing(uint32_t capacity, uint32_t threadIndex, uint64_t traceGeneration);
+
+    //must only be called by the owning thread
+    //the cell is written with relaxed stores after a release fence, so that
+    //a snapshot which reads any of them also sees head at h (seqlock style)
+    void record(TraceEventType type, uint64_t emissionId, uint32_t slotId){
+        uint64_t h = head.load(std::memory_order_relaxed);
+        Cell& cell = events[h & mask];
+        std::atomic_thread_fence(std::memory_order_release);
+        cell.timestamp.store(getMetricsTimestamp(), std::memory_order_relaxed);
+        cell.emissionId.store(emissionId, std::memory_order_relaxed);
+        cell.slotId.store(slotId, std::memory_order_relaxed);
+        cell.type.store(type, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    //emission ids are unique across threads without being shared between them
+    uint64_t nextEmissionId(){
+        return ((uint64_t)(thread + 1) << 40) | ++emissions;
+    }
+
+    //events which weren't overwritten while they were being copied
+    std::vector<TraceEvent> snapshot() const;
+
+    const uint32_t thread;
+    const uint64_t generation;
+
+private:
+    //a TraceEvent, read by snapshot while the owner may be overwriting it
+    struct Cell{
+        std::atomic<uint64_t> timestamp{0};
+        std::atomic<uint64_t> emissionId{0};
+        std::atomic<uint32_t> slotId{0};
+        std::atomic<TraceEventType> type{TraceEventType::EMIT_BEGIN};
+    };
+
+    std::vector<Cell> events;
+    const uint64_t mask;
+    std::atomic<uint64_t> head{0};
+    uint64_t emissions{0};
+};
+
+class Tracer{
+public:
+    //events of a previous trace are discarded
+    static void start(uint32_t eventsPerThread);
+    static void stop();
+
+    static bool isEnabled(){
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    static void record(TraceEventType type, uint64_t emissionId, uint32_t slotId){
+        getRing().record(type, emissionId, slotId);
+    }
+
+    static uint64_t nextEmissionId(){
+        return getRing().nextEmissionId();
+    }
+
+    //traced emission being dispatched by the calling thread, or 0
+    static uint64_t getCurrentEmission(){
+        return currentEmission;
+    }
+
+    static void setCurrentEmission(uint64_t emissionId){
+        currentEmission = emissionId;
+    }
+
+    //set by thread pool workers while running a task taken from another spoke
+    static bool isRunningStolenTask(){
+        return runningStolenTask;
+    }
+
+    static void setRunningStolenTask(bool stolen){
+        runningStolenTask = stolen;
+    }
+
+    //events of every thread which recorded any since the trace started
+    static std::vector<ThreadTrace> collect();
+
+private:
+    static TraceRing& getRing(){
+        TraceRing* ring = localRingPtr;
+        if (!ring || ring->generation != generation.load(std::memory_order_acquire)) ring = attachRing();
+        return *ring;
+    }
+
+    static TraceRing* attachRing();
+
+    static std::atomic<bool> enabled;
+    static std::atomic<uint64_t> generation;
+    static std::mutex registryLock;
+    static uint32_t ringCapacity;
+    static uint32_t nThreads;
+    static std::vector<std::shared_ptr<TraceRing>> rings;
+    //the ring is owned by localRing, and read through a plain pointer, which
+    //doesn't need the initialization check of a non trivial thread_local
+    static thread_local std::shared_ptr<TraceRing> localRing;
+    static thread_local TraceRing* localRingPtr;
+    static thread_local uint64_t currentEmission;
+    static thread_local bool runningStolenTask;
+};
+
+}}
+
+#endif /* BSIGNALS_TRACER_H */
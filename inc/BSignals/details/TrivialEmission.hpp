@@ -0,0 +1,76 @@
+/*
+ * File:   TrivialEmission.hpp
+ * Author: Barath Kannan
+ * Emitted arguments held in raw, trivially copyable storage, for emissions
+ * which are written to memory outside this process (shared memory rings and
+ * recorded traces). std::tuple itself is not trivially copyable, but a tuple
+ * of trivially copyable types can be constructed in storage which is.
+ * Created on 20 October 2026, 3:20 AM
+ */
+
+#ifndef BSIGNALS_TRIVIALEMISSION_HPP
+#define BSIGNALS_TRIVIALEMISSION_HPP
+
+#include <new>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include <initializer_list>
+
+namespace BSignals{ namespace details{
+
+template <typename... Args>
+struct AllTriviallyCopyable : std::true_type{};
+
+template <typename First, typename... Rest>
+struct AllTriviallyCopyable<First, Rest...>
+: std::integral_constant<bool, std::is_trivially_copyable<First>::value && AllTriviallyCopyable<Rest...>::value>{};
+
+template <typename... Args>
+struct TrivialEmission{
+    typedef std::tuple<Args...> ArgsTuple;
+
+    TrivialEmission(const Args& ... p){
+        new (&storage) ArgsTuple(p...);
+    }
+
+    const ArgsTuple& getArgs() const{
+        return *reinterpret_cast<const ArgsTuple*>(&storage);
+    }
+
+    //calls f with the arguments, by reference into the storage
+    template <typename F>
+    void apply(F&& f) const{
+        applyImpl(std::forward<F>(f), std::index_sequence_for<Args...>());
+    }
+
+    //summary of the argument types, to catch memory written with different
+    //Args (types with the same size and category aren't told apart)
+    static uint64_t getSignature(){
+        uint64_t signature = sizeof...(Args);
+        for (uint64_t traits : std::initializer_list<uint64_t>{getTraits<Args>()...}){
+            signature = signature*1099511628211ULL ^ traits;
+        }
+        return signature;
+    }
+
+    typename std::aligned_storage<sizeof(ArgsTuple), alignof(ArgsTuple)>::type storage;
+
+private:
+    template <typename T>
+    static constexpr uint64_t getTraits(){
+        return sizeof(T) | alignof(T) << 16 | (uint64_t)std::is_integral<T>::value << 32 |
+                (uint64_t)std::is_floating_point<T>::value << 33 | (uint64_t)std::is_signed<T>::value << 34 |
+                (uint64_t)std::is_pointer<T>::value << 35 | (uint64_t)std::is_enum<T>::value << 36;
+    }
+
+    template <typename F, std::size_t... Is>
+    void applyImpl(F&& f, std::index_sequence<Is...>) const{
+        f(std::get<Is>(getArgs())...);
+    }
+};
+
+}}
+
+#endif /* BSIGNALS_TRIVIALEMISSION_HPP */
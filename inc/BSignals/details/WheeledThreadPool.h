@@ -11,6 +11,8 @@
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <array>
+#include "BSignals/Metrics.h"
 #include "BSignals/details/Wheel.hpp"
 #include "BSignals/details/MPSCQueue.hpp"
 
@@ -27,12 +29,25 @@ public:
         run([task, p...](){task(p...);});
     }
     
-    static void run(const std::function<void()> task) noexcept;
+    static void run(std::function<void()> task) noexcept;
+    
+    //as run, but the task is counted on its spoke if metrics are enabled
+    //(used by instrumented slots, so that run carries no metrics check)
+    static void runCounted(std::function<void()> task) noexcept;
     
     //only invoke start up if a thread pooled slot has been connected
     static void startup();
     
     static std::chrono::duration<double> getMaxWait();
+    
+    //true on the pool's worker threads, which must not block waiting on
+    //other pool tasks
+    static bool isPoolThread();
+    
+    //tasks posted through runCounted to and taken from each spoke are only
+    //counted once enabled
+    static void enableMetrics(bool enable);
+    static std::vector<BSignals::SpokeMetricsSnapshot> getMetrics();
 private:
     static void queueListener(uint32_t index);
     static class _init {
@@ -42,11 +57,22 @@ private:
     } _initializer;
     
     static const uint32_t nThreads{32};
+    //maximum number of tasks a thread runs from its own spoke before it
+    //transfers waiting tasks to the cache again
+    static const uint32_t batchSize{16};
     static std::chrono::duration<double> maxWait;
     static std::mutex tpLock;
     static bool isStarted;
     static Wheel<MPSCQueue<std::function<void()>, 256>, BSignals::details::WheeledThreadPool::nThreads> threadPooledFunctions;
     static std::vector<std::thread> queueMonitors;
+    static thread_local bool poolThread;
+    
+    struct alignas(64) SpokeCounters{
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> dequeued{0};
+    };
+    static std::atomic<bool> metricsEnabled;
+    static std::array<SpokeCounters, nThreads> spokeCounters;
 };
 }}
 
@@ -0,0 +1,37 @@
+#include "BSignals/CompletionHandle.h"
+
+using BSignals::CompletionHandle;
+
+CompletionHandle::CompletionHandle(details::CompletionState* s)
+: state(s) {}
+
+CompletionHandle::CompletionHandle(CompletionHandle&& that) noexcept
+: state(that.state) {
+    that.state = nullptr;
+}
+
+CompletionHandle& CompletionHandle::operator=(CompletionHandle&& that) noexcept {
+    if (this != &that){
+        if (state) state->release();
+        state = that.state;
+        that.state = nullptr;
+    }
+    return *this;
+}
+
+CompletionHandle::~CompletionHandle() {
+    if (state) state->release();
+}
+
+bool CompletionHandle::isComplete() const {
+    return (!state || state->isComplete());
+}
+
+void CompletionHandle::wait() {
+    if (state) state->wait();
+}
+
+void CompletionHandle::then(std::function<void()> continuation) {
+    if (state) state->then(std::move(continuation));
+    else continuation();
+}
@@ -0,0 +1,78 @@
+#include "BSignals/EventLoop.h"
+#include <system_error>
+#include <cerrno>
+
+#ifdef LINUX
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+using BSignals::EventLoop;
+
+EventLoop::EventLoop() {
+#ifdef LINUX
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0){
+        throw std::system_error(errno, std::system_category(), "eventfd");
+    }
+#endif
+}
+
+EventLoop::~EventLoop() {
+#ifdef LINUX
+    close(eventFd);
+#endif
+}
+
+void EventLoop::post(std::function<void()> task) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(postLock);
+        wasEmpty = pending.empty();
+        pending.emplace_back(std::move(task));
+    }
+    //only the first post after a swap needs to wake the owner
+    if (wasEmpty) signalEventFd();
+}
+
+uint32_t EventLoop::runPending() {
+    std::lock_guard<std::mutex> runGuard(runLock);
+    //cleared before the swap, so a post that lands after the swap
+    //re-signals rather than being missed
+    clearEventFd();
+    {
+        std::lock_guard<std::mutex> lock(postLock);
+        pending.swap(running);
+    }
+    for (auto &task : running){
+        task();
+    }
+    uint32_t nRun = running.size();
+    running.clear();
+    return nRun;
+}
+
+bool EventLoop::hasPending() const {
+    std::lock_guard<std::mutex> lock(postLock);
+    return !pending.empty();
+}
+
+int EventLoop::getEventFd() const {
+    return eventFd;
+}
+
+void EventLoop::signalEventFd() {
+#ifdef LINUX
+    uint64_t one = 1;
+    //can only fail if the counter would overflow, in which case it is
+    //already readable
+    if (write(eventFd, &one, sizeof(one))) {}
+#endif
+}
+
+void EventLoop::clearEventFd() {
+#ifdef LINUX
+    uint64_t value;
+    if (read(eventFd, &value, sizeof(value))) {}
+#endif
+}
@@ -0,0 +1,65 @@
+#include "BSignals/Metrics.h"
+#include "BSignals/details/LatencyHistogram.h"
+#include "BSignals/details/WheeledThreadPool.h"
+#include <algorithm>
+
+using BSignals::HistogramSnapshot;
+using BSignals::SpokeMetricsSnapshot;
+using BSignals::details::LatencyHistogram;
+using BSignals::details::WheeledThreadPool;
+
+uint64_t HistogramSnapshot::getPercentile(double percentile) const {
+    if (count == 0) return 0;
+    uint64_t rank = (uint64_t)(std::min(std::max(percentile, 0.0), 100.0)/100.0*count);
+    uint64_t seen = 0;
+    for (size_t i=0; i<buckets.size(); ++i){
+        seen += buckets[i];
+        if (seen > rank || seen == count) return getBucketUpperBound(i);
+    }
+    return getMax();
+}
+
+uint64_t HistogramSnapshot::getMax() const {
+    for (size_t i=buckets.size(); i>0; --i){
+        if (buckets[i-1] != 0) return getBucketUpperBound(i-1);
+    }
+    return 0;
+}
+
+double HistogramSnapshot::getMean() const {
+    if (count == 0) return 0;
+    double sum = 0;
+    for (size_t i=0; i<buckets.size(); ++i){
+        if (buckets[i] == 0) continue;
+        sum += buckets[i]*((double)getBucketLowerBound(i) + (double)getBucketUpperBound(i))/2;
+    }
+    return sum/count;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& that) {
+    if (buckets.size() < that.buckets.size()) buckets.resize(that.buckets.size(), 0);
+    for (size_t i=0; i<that.buckets.size(); ++i){
+        buckets[i] += that.buckets[i];
+    }
+    count += that.count;
+}
+
+uint64_t HistogramSnapshot::getBucketLowerBound(size_t bucket) {
+    if (bucket < LatencyHistogram::subBuckets) return bucket;
+    size_t shift = (bucket - LatencyHistogram::subBuckets)/LatencyHistogram::subBuckets;
+    size_t subBucket = (bucket - LatencyHistogram::subBuckets)%LatencyHistogram::subBuckets;
+    return (uint64_t)(LatencyHistogram::subBuckets + subBucket) << shift;
+}
+
+uint64_t HistogramSnapshot::getBucketUpperBound(size_t bucket) {
+    if (bucket + 1 >= LatencyHistogram::nBuckets) return UINT64_MAX;
+    return getBucketLowerBound(bucket + 1) - 1;
+}
+
+void BSignals::enableThreadPoolMetrics(bool enable) {
+    WheeledThreadPool::enableMetrics(enable);
+}
+
+std::vector<SpokeMetricsSnapshot> BSignals::getThreadPoolMetrics() {
+    return WheeledThreadPool::getMetrics();
+}
@@ -0,0 +1,186 @@
+#include "BSignals/SignalGraph.h"
+#include "BSignals/CompletionHandle.h"
+#include "BSignals/details/CompletionState.h"
+#include "BSignals/details/WheeledThreadPool.h"
+#include <stdexcept>
+#include <algorithm>
+
+using BSignals::SignalGraph;
+using BSignals::CompletionHandle;
+using BSignals::details::CompletionState;
+using BSignals::details::CompletionToken;
+using BSignals::details::WheeledThreadPool;
+
+uint32_t SignalGraph::addNode(const std::string& name, std::function<void()> task) {
+    nodes.emplace_back();
+    nodes.back().task = std::move(task);
+    nodes.back().timing.name = name;
+    compiled = false;
+    return (uint32_t)(nodes.size() - 1);
+}
+
+void SignalGraph::addEdge(uint32_t from, uint32_t to) {
+    if (from >= nodes.size() || to >= nodes.size()){
+        throw std::out_of_range("SignalGraph::addEdge: unknown node");
+    }
+    nodes[from].successors.push_back(to);
+    ++nodes[to].nPredecessors;
+    compiled = false;
+}
+
+void SignalGraph::run() {
+    if (WheeledThreadPool::isPoolThread()){
+        throw std::logic_error("SignalGraph::run: called on a pool thread, use runAsync");
+    }
+    if (!compiled) compile();
+    for (auto const &wave : waves){
+        if (wave.size() == 1){
+            runSegment(wave.front());
+            continue;
+        }
+        CompletionState* state = CompletionState::acquire();
+        CompletionHandle handle(state);
+        for (size_t i=1; i<wave.size(); ++i){
+            state->addPending();
+            WheeledThreadPool::run([this, segment = wave[i], token = CompletionToken(state)]() mutable{
+                runSegment(segment);
+                token.reset();
+            });
+        }
+        runSegment(wave.front());
+        state->countDown();
+        handle.wait();
+    }
+}
+
+CompletionHandle SignalGraph::runAsync() {
+    if (!compiled) compile();
+    CompletionState* state = CompletionState::acquire();
+    CompletionHandle handle(state);
+    WheeledThreadPool::run([this, done = CompletionToken(state)]() mutable{
+        runWaves(0, std::move(done));
+    });
+    return handle;
+}
+
+void SignalGraph::runWaves(size_t wave, CompletionToken done) {
+    //waves of a single segment run inline on the current worker
+    for (; wave < waves.size() && waves[wave].size() == 1; ++wave){
+        runSegment(waves[wave].front());
+    }
+    //done is released (completing the run) once the last wave has completed
+    if (wave == waves.size()) return;
+    CompletionState* state = CompletionState::acquire();
+    CompletionHandle handle(state);
+    handle.then([this, wave, done = std::move(done)]() mutable{
+        runWaves(wave + 1, std::move(done));
+    });
+    for (auto segment : waves[wave]){
+        state->addPending();
+        WheeledThreadPool::run([this, segment, token = CompletionToken(state)]() mutable{
+            runSegment(segment);
+            token.reset();
+        });
+    }
+    state->countDown();
+}
+
+uint32_t SignalGraph::getWaveCount() const {
+    return (uint32_t)waves.size();
+}
+
+const SignalGraph::NodeTiming& SignalGraph::getNodeTiming(uint32_t node) const {
+    return nodes.at(node).timing;
+}
+
+std::vector<uint32_t> SignalGraph::getCriticalPath(std::chrono::nanoseconds* length) const {
+    std::vector<uint32_t> path;
+    if (length) *length = std::chrono::nanoseconds(0);
+    if (!compiled || nodes.empty()) return path;
+    //earliest start of each node, were every node to take its last timing
+    std::vector<std::chrono::nanoseconds> start(nodes.size(), std::chrono::nanoseconds(0));
+    std::vector<uint32_t> previous(nodes.size(), UINT32_MAX);
+    uint32_t last = topologicalOrder.front();
+    std::chrono::nanoseconds longest(-1);
+    for (auto n : topologicalOrder){
+        auto finish = start[n] + nodes[n].timing.last;
+        if (finish > longest){
+            longest = finish;
+            last = n;
+        }
+        for (auto s : nodes[n].successors){
+            if (previous[s] == UINT32_MAX || finish > start[s]){
+                start[s] = finish;
+                previous[s] = n;
+            }
+        }
+    }
+    for (uint32_t n = last; n != UINT32_MAX; n = previous[n]){
+        path.push_back(n);
+    }
+    std::reverse(path.begin(), path.end());
+    if (length) *length = longest;
+    return path;
+}
+
+void SignalGraph::compile() {
+    //Kahn's algorithm
+    topologicalOrder.clear();
+    std::vector<uint32_t> remaining(nodes.size());
+    for (uint32_t n=0; n<nodes.size(); ++n){
+        remaining[n] = nodes[n].nPredecessors;
+        if (remaining[n] == 0) topologicalOrder.push_back(n);
+    }
+    for (size_t i=0; i<topologicalOrder.size(); ++i){
+        for (auto s : nodes[topologicalOrder[i]].successors){
+            if (--remaining[s] == 0) topologicalOrder.push_back(s);
+        }
+    }
+    if (topologicalOrder.size() != nodes.size()){
+        throw std::invalid_argument("SignalGraph::run: graph contains a cycle");
+    }
+
+    //a node joins its predecessor's segment if each is the other's only link
+    segments.clear();
+    std::vector<uint32_t> segmentOf(nodes.size(), UINT32_MAX);
+    for (auto n : topologicalOrder){
+        if (segmentOf[n] != UINT32_MAX) continue;
+        segments.emplace_back();
+        for (uint32_t c = n;;){
+            segments.back().push_back(c);
+            segmentOf[c] = (uint32_t)(segments.size() - 1);
+            if (nodes[c].successors.size() != 1) break;
+            c = nodes[c].successors.front();
+            if (nodes[c].nPredecessors != 1) break;
+        }
+    }
+
+    //a segment's wave is one past the latest wave of any of its predecessors
+    std::vector<uint32_t> level(segments.size(), 0);
+    for (auto n : topologicalOrder){
+        for (auto s : nodes[n].successors){
+            if (segmentOf[s] != segmentOf[n]){
+                level[segmentOf[s]] = std::max(level[segmentOf[s]], level[segmentOf[n]] + 1);
+            }
+        }
+    }
+    waves.clear();
+    for (uint32_t seg=0; seg<segments.size(); ++seg){
+        if (level[seg] >= waves.size()) waves.resize(level[seg] + 1);
+        waves[level[seg]].push_back(seg);
+    }
+
+    WheeledThreadPool::startup();
+    compiled = true;
+}
+
+void SignalGraph::runSegment(uint32_t segment) {
+    for (auto n : segments[segment]){
+        Node& node = nodes[n];
+        auto begin = std::chrono::steady_clock::now();
+        node.task();
+        node.timing.last = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+        node.timing.total += node.timing.last;
+        ++node.timing.runs;
+    }
+}
@@ -0,0 +1,141 @@
+#include "BSignals/Tracing.h"
+#include "BSignals/details/Tracer.h"
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+using BSignals::details::TraceEvent;
+using BSignals::details::TraceEventType;
+using BSignals::details::ThreadTrace;
+using BSignals::details::Tracer;
+
+namespace{
+
+const char* getEventName(TraceEventType type){
+    switch(type){
+        case(TraceEventType::EMIT_BEGIN):
+        case(TraceEventType::EMIT_END):
+            return "emit";
+        case(TraceEventType::DISPATCH_BEGIN):
+        case(TraceEventType::DISPATCH_END):
+            return "dispatch";
+        case(TraceEventType::ENQUEUE):
+            return "enqueue";
+        case(TraceEventType::DEQUEUE):
+            return "dequeue";
+        case(TraceEventType::STEAL):
+            return "steal";
+        case(TraceEventType::EXECUTE_BEGIN):
+        case(TraceEventType::EXECUTE_END):
+            return "execute";
+    }
+    return "";
+}
+
+const char* getPhase(TraceEventType type){
+    switch(type){
+        case(TraceEventType::EMIT_BEGIN):
+        case(TraceEventType::DISPATCH_BEGIN):
+        case(TraceEventType::EXECUTE_BEGIN):
+            return "B";
+        case(TraceEventType::EMIT_END):
+        case(TraceEventType::DISPATCH_END):
+        case(TraceEventType::EXECUTE_END):
+            return "E";
+        default:
+            return "i";
+    }
+}
+
+class ChromeTraceWriter{
+public:
+    ChromeTraceWriter(std::ostream& o, uint64_t firstTimestamp) : out(o), origin(firstTimestamp){}
+
+    void writeThreadName(uint32_t thread){
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+            << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+    }
+
+    void writeEvent(uint32_t thread, const TraceEvent& e){
+        bool hasSlot = (e.type != TraceEventType::EMIT_BEGIN && e.type != TraceEventType::EMIT_END);
+        separate();
+        out << "{\"name\":\"" << getEventName(e.type) << "\",\"cat\":\"bsignals\",\"ph\":\"" << getPhase(e.type) << "\"";
+        if (e.type == TraceEventType::ENQUEUE || e.type == TraceEventType::DEQUEUE || e.type == TraceEventType::STEAL){
+            out << ",\"s\":\"t\"";
+        }
+        writeLocation(thread, e.timestamp);
+        out << ",\"args\":{\"emission\":" << e.emissionId;
+        if (hasSlot) out << ",\"slot\":" << e.slotId;
+        out << "}}";
+        //the handoff flows from the enqueue into the execution slice
+        if (e.type == TraceEventType::ENQUEUE) writeFlow(thread, e, "s");
+        else if (e.type == TraceEventType::EXECUTE_BEGIN) writeFlow(thread, e, "f");
+    }
+
+private:
+    void writeFlow(uint32_t thread, const TraceEvent& e, const char* phase){
+        separate();
+        out << "{\"name\":\"handoff\",\"cat\":\"bsignals\",\"ph\":\"" << phase << "\"";
+        if (phase[0] == 'f') out << ",\"bp\":\"e\"";
+        out << ",\"id\":\"" << e.emissionId << ":" << e.slotId << "\"";
+        writeLocation(thread, e.timestamp);
+        out << "}";
+    }
+
+    void writeLocation(uint32_t thread, uint64_t timestamp){
+        //microseconds since the first event
+        char ts[32];
+        uint64_t ns = (timestamp > origin ? timestamp - origin : 0);
+        std::snprintf(ts, sizeof(ts), "%llu.%03llu", (unsigned long long)(ns/1000), (unsigned long long)(ns%1000));
+        out << ",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << thread;
+    }
+
+    void separate(){
+        if (!first) out << ",\n";
+        first = false;
+    }
+
+    std::ostream& out;
+    const uint64_t origin;
+    bool first{true};
+};
+
+}
+
+void BSignals::startTracing(uint32_t eventsPerThread) {
+    Tracer::start(eventsPerThread);
+}
+
+void BSignals::stopTracing() {
+    Tracer::stop();
+}
+
+bool BSignals::isTracing() {
+    return Tracer::isEnabled();
+}
+
+void BSignals::exportChromeTrace(std::ostream& out) {
+    std::vector<ThreadTrace> traces = Tracer::collect();
+    uint64_t origin = UINT64_MAX;
+    for (auto const &trace : traces){
+        if (!trace.events.empty()) origin = std::min(origin, trace.events.front().timestamp);
+    }
+    ChromeTraceWriter writer(out, origin);
+    out << "{\"traceEvents\":[\n";
+    for (auto const &trace : traces){
+        writer.writeThreadName(trace.thread);
+        for (auto const &e : trace.events){
+            writer.writeEvent(trace.thread, e);
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+bool BSignals::exportChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) return false;
+    exportChromeTrace(file);
+    file.close();
+    return !file.fail();
+}
@@ -0,0 +1,106 @@
+#include "BSignals/details/CompletionState.h"
+#include "BSignals/details/ContiguousMPMCQueue.hpp"
+#include <thread>
+
+using BSignals::details::CompletionState;
+using BSignals::details::ContiguousMPMCQueue;
+
+namespace BSignals{ namespace details{
+//states beyond the capacity of the pool are freed rather than recycled
+struct CompletionStatePool{
+    ~CompletionStatePool(){
+        CompletionState* state;
+        while (free.dequeue(state)) delete state;
+    }
+
+    CompletionState* acquire(){
+        CompletionState* state;
+        if (!free.dequeue(state)){
+            state = new CompletionState;
+            allocated.fetch_add(1, std::memory_order_relaxed);
+        }
+        return state;
+    }
+
+    void recycle(CompletionState* state){
+        state->done = false;
+        state->continuation = nullptr;
+        if (!free.enqueue(state)) delete state;
+    }
+
+    ContiguousMPMCQueue<CompletionState*, 1024> free;
+    std::atomic<uint64_t> allocated{0};
+};
+}}
+
+namespace{
+BSignals::details::CompletionStatePool pool;
+}
+
+CompletionState* CompletionState::acquire() {
+    CompletionState* state = pool.acquire();
+    state->pending.store(1, std::memory_order_relaxed);
+    state->refs.store(2, std::memory_order_relaxed);
+    return state;
+}
+
+uint64_t CompletionState::getAllocatedCount() {
+    return pool.allocated.load(std::memory_order_relaxed);
+}
+
+void CompletionState::addPending() {
+    pending.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CompletionState::countDown() {
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) complete();
+}
+
+void CompletionState::release() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) pool.recycle(this);
+}
+
+bool CompletionState::isComplete() const {
+    return (pending.load(std::memory_order_acquire) == 0);
+}
+
+void CompletionState::wait() {
+    //most slots are short, so spin briefly before blocking
+    for (uint32_t i=0; i<64; ++i){
+        if (isComplete()) return;
+        std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(waitLock);
+    while (!done){
+        waitCV.wait(lock);
+    }
+}
+
+bool CompletionState::waitFor(std::chrono::nanoseconds timeout) {
+    if (isComplete()) return true;
+    std::unique_lock<std::mutex> lock(waitLock);
+    return waitCV.wait_for(lock, timeout, [this](){return done;});
+}
+
+void CompletionState::then(std::function<void()> f) {
+    {
+        std::lock_guard<std::mutex> lock(waitLock);
+        if (!done){
+            continuation = std::move(f);
+            return;
+        }
+    }
+    f();
+}
+
+void CompletionState::complete() {
+    std::function<void()> f;
+    {
+        std::lock_guard<std::mutex> lock(waitLock);
+        done = true;
+        f.swap(continuation);
+        waitCV.notify_all();
+    }
+    if (f) f();
+    release();
+}
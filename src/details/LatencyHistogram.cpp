@@ -0,0 +1,52 @@
+#include "BSignals/details/LatencyHistogram.h"
+
+using BSignals::HistogramSnapshot;
+using BSignals::SlotMetricsSnapshot;
+using BSignals::details::LatencyHistogram;
+using BSignals::details::ShardedCounter;
+using BSignals::details::SlotMetrics;
+
+BSignals::details::ShardCacheEntry* BSignals::details::getShardCache() {
+    thread_local ShardCacheEntry cache[shardCacheSize];
+    return cache;
+}
+
+uint64_t BSignals::details::getNextShardsId() {
+    //0 marks an empty cache entry
+    static std::atomic<uint64_t> nextId{1};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.buckets.assign(nBuckets, 0);
+    shards.forEach([&snapshot](const Shard& shard){
+        for (uint32_t i=0; i<nBuckets; ++i){
+            uint64_t n = shard.buckets[i].load(std::memory_order_relaxed);
+            snapshot.buckets[i] += n;
+            snapshot.count += n;
+        }
+    });
+    return snapshot;
+}
+
+uint64_t ShardedCounter::load() const {
+    uint64_t total = 0;
+    shards.forEach([&total](const Shard& shard){
+        total += shard.value.load(std::memory_order_relaxed);
+    });
+    return total;
+}
+
+SlotMetricsSnapshot SlotMetrics::snapshot() const {
+    SlotMetricsSnapshot snapshot;
+    snapshot.slotId = slotId;
+    snapshot.scheme = scheme;
+    snapshot.executionTime = executionTime.snapshot();
+    snapshot.sojournTime = sojournTime.snapshot();
+    //dequeued first, so a concurrent emission can't make it exceed enqueued
+    snapshot.dequeued = dequeued.load();
+    snapshot.enqueued = enqueued.load();
+    snapshot.depth = (snapshot.enqueued > snapshot.dequeued ? snapshot.enqueued - snapshot.dequeued : 0);
+    return snapshot;
+}
@@ -0,0 +1,65 @@
+#include "BSignals/details/MappedFile.h"
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using BSignals::details::MappedFile;
+
+namespace{
+[[noreturn]] void throwError(int fd, const std::string& what){
+    int error = errno;
+    if (fd >= 0) close(fd);
+    throw std::system_error(error, std::system_category(), what);
+}
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size)
+: size(size), length(size), writable(true) {
+    fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) throwError(fd, "MappedFile: open " + path);
+    if (ftruncate(fd, (off_t)size) != 0) throwError(fd, "MappedFile: ftruncate " + path);
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) throwError(fd, "MappedFile: mmap " + path);
+}
+
+MappedFile::MappedFile(const std::string& path) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throwError(fd, "MappedFile: open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) throwError(fd, "MappedFile: fstat " + path);
+    size = length = (size_t)st.st_size;
+    if (size == 0){
+        errno = EINVAL;
+        throwError(fd, "MappedFile: empty file " + path);
+    }
+    data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) throwError(fd, "MappedFile: mmap " + path);
+}
+
+MappedFile::~MappedFile() {
+    munmap(data, size);
+    if (writable && length < size){
+        //nothing useful can be done if this fails, the tail is just unused
+        if (ftruncate(fd, (off_t)length) != 0) {}
+    }
+    close(fd);
+}
+
+void* MappedFile::getData() const {
+    return data;
+}
+
+size_t MappedFile::getSize() const {
+    return size;
+}
+
+void MappedFile::setLength(size_t l) {
+    length = (l < size ? l : size);
+}
+
+void MappedFile::sync() {
+    msync(data, size, MS_SYNC);
+}
@@ -16,6 +16,9 @@ void Semaphore::acquire() {
 }
 
 void Semaphore::release() {
+    //under the mutex, so that a waiter between checking the count and
+    //sleeping can't miss the notification
+    std::lock_guard<std::mutex> lock(semMutex);
     ++semCounter;
     semCV.notify_one();
 }
@@ -0,0 +1,116 @@
+#include "BSignals/details/SharedMemoryRegion.h"
+#include <system_error>
+#include <cerrno>
+#include <thread>
+
+#ifdef LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+using BSignals::details::SharedMemoryRegion;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32 bit integer");
+
+namespace{
+[[noreturn]] void throwError(const std::string& what){
+    throw std::system_error(errno, std::system_category(), what);
+}
+}
+
+#ifdef LINUX
+SharedMemoryRegion::SharedMemoryRegion(const std::string& name, size_t size)
+: name(name), size(size), owner(true) {
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) throwError("SharedMemoryRegion: shm_open " + name);
+    if (ftruncate(fd, (off_t)size) != 0){
+        int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        errno = error;
+        throwError("SharedMemoryRegion: ftruncate " + name);
+    }
+    map(fd);
+}
+
+SharedMemoryRegion::SharedMemoryRegion(const std::string& name)
+: name(name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) throwError("SharedMemoryRegion: shm_open " + name);
+    struct stat st;
+    if (fstat(fd, &st) != 0){
+        int error = errno;
+        close(fd);
+        errno = error;
+        throwError("SharedMemoryRegion: fstat " + name);
+    }
+    size = (size_t)st.st_size;
+    map(fd);
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    munmap(data, size);
+    if (owner) shm_unlink(name.c_str());
+}
+
+#else
+//shared memory regions are only implemented for linux
+SharedMemoryRegion::SharedMemoryRegion(const std::string& name, size_t size)
+: name(name), size(size), owner(true) {
+    errno = ENOSYS;
+    throwError("SharedMemoryRegion: " + name);
+}
+
+SharedMemoryRegion::SharedMemoryRegion(const std::string& name)
+: name(name) {
+    errno = ENOSYS;
+    throwError("SharedMemoryRegion: " + name);
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+}
+#endif
+
+void* SharedMemoryRegion::getData() const {
+    return data;
+}
+
+size_t SharedMemoryRegion::getSize() const {
+    return size;
+}
+
+#ifdef LINUX
+void SharedMemoryRegion::map(int fd) {
+    //the mapping keeps the object alive, the descriptor isn't needed
+    void* mapping = (size == 0 ? MAP_FAILED : mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    int error = (size == 0 ? EINVAL : errno);
+    close(fd);
+    if (mapping == MAP_FAILED){
+        if (owner) shm_unlink(name.c_str());
+        errno = error;
+        throwError("SharedMemoryRegion: mmap " + name);
+    }
+    data = mapping;
+}
+
+#endif
+
+void BSignals::details::futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#ifdef LINUX
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+    //waiters tolerate spurious returns, so without futexes this polls
+    if (word.load(std::memory_order_acquire) == expected) std::this_thread::yield();
+#endif
+}
+
+void BSignals::details::futexWake(std::atomic<uint32_t>& word, int count) {
+#ifdef LINUX
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+#endif
+}
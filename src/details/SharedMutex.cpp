@@ -4,7 +4,7 @@
 using BSignals::details::SharedMutex;
 
 void SharedMutex::lock() {
-    m_writers.fetch_add(1, std::memory_order_release);
+    m_writers.fetch_add(1, std::memory_order_seq_cst);
     std::unique_lock<std::mutex> lock(m_mutex);
     while (m_readers || m_writer){
         m_condVar.wait(lock);
@@ -13,23 +13,31 @@ void SharedMutex::lock() {
 }
 
 void SharedMutex::unlock() {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_writer.store(false, std::memory_order_release);
     m_writers.fetch_sub(1, std::memory_order_release);
-    m_condVar.notify_one();
+    m_condVar.notify_all();
 }
 
 void SharedMutex::lock_shared(){
-    m_readers.fetch_add(1, std::memory_order_release);
-    if (m_writers.load(std::memory_order_acquire)){
-        m_readers.fetch_sub(1, std::memory_order_release);
+    //writers must be rechecked after every increment, otherwise a writer
+    //that arrived while backing off could be let in alongside this reader
+    while (true){
+        m_readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!m_writers.load(std::memory_order_seq_cst)) return;
+        unlock_shared();
         while (m_writers.load(std::memory_order_acquire)){
             std::this_thread::yield();
         }
-        m_readers.fetch_add(1, std::memory_order_release);
     }
 }
 
 void SharedMutex::unlock_shared() {
-    m_readers.fetch_sub(1, std::memory_order_release);
-    if (m_writers.load(std::memory_order_acquire)) m_condVar.notify_one();
+    m_readers.fetch_sub(1, std::memory_order_seq_cst);
+    if (m_writers.load(std::memory_order_seq_cst)){
+        //notify under the mutex so that it can't slip in between a
+        //writer checking m_readers and going to sleep
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condVar.notify_all();
+    }
 }
@@ -0,0 +1,82 @@
+#include "BSignals/details/Tracer.h"
+#include <algorithm>
+
+using BSignals::details::TraceEvent;
+using BSignals::details::ThreadTrace;
+using BSignals::details::TraceRing;
+using BSignals::details::Tracer;
+
+std::atomic<bool> Tracer::enabled{false};
+std::atomic<uint64_t> Tracer::generation{0};
+std::mutex Tracer::registryLock;
+uint32_t Tracer::ringCapacity{0};
+uint32_t Tracer::nThreads{0};
+std::vector<std::shared_ptr<TraceRing>> Tracer::rings;
+thread_local std::shared_ptr<TraceRing> Tracer::localRing;
+thread_local TraceRing* Tracer::localRingPtr{nullptr};
+thread_local uint64_t Tracer::currentEmission{0};
+thread_local bool Tracer::runningStolenTask{false};
+
+TraceRing::TraceRing(uint32_t capacity, uint32_t threadIndex, uint64_t traceGeneration)
+: thread(threadIndex), generation(traceGeneration), events(capacity), mask(capacity - 1) {}
+
+std::vector<TraceEvent> TraceRing::snapshot() const {
+    const uint64_t capacity = mask + 1;
+    uint64_t end = head.load(std::memory_order_acquire);
+    uint64_t begin = (end > capacity ? end - capacity : 0);
+    std::vector<TraceEvent> copy;
+    copy.reserve(end - begin);
+    for (uint64_t i=begin; i<end; ++i){
+        const Cell& cell = events[i & mask];
+        copy.push_back(TraceEvent{cell.timestamp.load(std::memory_order_relaxed), cell.emissionId.load(std::memory_order_relaxed),
+                cell.slotId.load(std::memory_order_relaxed), cell.type.load(std::memory_order_relaxed)});
+    }
+    //the owner may have wrapped over the oldest events while they were copied
+    //the fence pairs with the one in record: if any copied field was written
+    //for event h, head is seen at h or later. While head is h, event h is
+    //being written over event h - capacity, so that one is dropped too
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t written = head.load(std::memory_order_relaxed);
+    uint64_t overwritten = (written + 1 > capacity ? written + 1 - capacity : 0);
+    if (overwritten > begin){
+        copy.erase(copy.begin(), copy.begin() + std::min(overwritten - begin, (uint64_t)copy.size()));
+    }
+    return copy;
+}
+
+void Tracer::start(uint32_t eventsPerThread) {
+    uint32_t capacity = 1;
+    while (capacity < eventsPerThread) capacity <<= 1;
+    std::lock_guard<std::mutex> lock(registryLock);
+    rings.clear();
+    nThreads = 0;
+    ringCapacity = capacity;
+    generation.fetch_add(1, std::memory_order_release);
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+std::vector<ThreadTrace> Tracer::collect() {
+    std::vector<std::shared_ptr<TraceRing>> current;
+    {
+        std::lock_guard<std::mutex> lock(registryLock);
+        current = rings;
+    }
+    std::vector<ThreadTrace> traces;
+    for (auto const &ring : current){
+        traces.push_back(ThreadTrace{ring->thread, ring->snapshot()});
+    }
+    return traces;
+}
+
+TraceRing* Tracer::attachRing() {
+    std::lock_guard<std::mutex> lock(registryLock);
+    //a ring is only ever created for the current trace
+    localRing = std::make_shared<TraceRing>(std::max(ringCapacity, 1u), nThreads++, generation.load(std::memory_order_relaxed));
+    rings.push_back(localRing);
+    localRingPtr = localRing.get();
+    return localRingPtr;
+}
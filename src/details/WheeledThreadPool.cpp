@@ -1,5 +1,6 @@
 #include "BSignals/details/WheeledThreadPool.h"
 #include "BSignals/details/BasicTimer.h"
+#include "BSignals/details/Tracer.h"
 #include <algorithm>
 
 using std::mutex;
@@ -10,12 +11,16 @@ using BSignals::details::Wheel;
 using BSignals::details::MPSCQueue;
 using BSignals::details::WheeledThreadPool;
 using BSignals::details::BasicTimer;
+using BSignals::details::Tracer;
 
 std::mutex WheeledThreadPool::tpLock;
 bool WheeledThreadPool::isStarted = false;
 std::chrono::duration<double> WheeledThreadPool::maxWait;
 Wheel<MPSCQueue<std::function<void()>, 256>, WheeledThreadPool::nThreads> WheeledThreadPool::threadPooledFunctions {};
 std::vector<std::thread> WheeledThreadPool::queueMonitors;
+thread_local bool WheeledThreadPool::poolThread{false};
+std::atomic<bool> WheeledThreadPool::metricsEnabled{false};
+std::array<WheeledThreadPool::SpokeCounters, WheeledThreadPool::nThreads> WheeledThreadPool::spokeCounters;
 
 WheeledThreadPool::_init WheeledThreadPool::_initializer;
 
@@ -43,11 +48,25 @@ WheeledThreadPool::_init::~_init() {
     }
 }
 
-void WheeledThreadPool::run(const std::function<void()> task) noexcept{
-    threadPooledFunctions.getSpoke().enqueue(task);
+void WheeledThreadPool::run(std::function<void()> task) noexcept{
+    threadPooledFunctions.getSpoke().enqueue(std::move(task));
     //threadPooledFunctions.getSpokeRandom().enqueue(task);
 }
 
+void WheeledThreadPool::runCounted(std::function<void()> task) noexcept{
+    if (!metricsEnabled.load(std::memory_order_relaxed)){
+        run(std::move(task));
+        return;
+    }
+    //the task counts itself as dequeued from its spoke, whichever worker runs it
+    uint32_t index = threadPooledFunctions.getIndex();
+    spokeCounters[index].enqueued.fetch_add(1, std::memory_order_relaxed);
+    threadPooledFunctions.getSpoke(index).enqueue([index, task = std::move(task)](){
+        spokeCounters[index].dequeued.fetch_add(1, std::memory_order_relaxed);
+        task();
+    });
+}
+
 void WheeledThreadPool::startup() {
     std::lock_guard<mutex> lock(tpLock);
     if (!isStarted){
@@ -62,7 +81,26 @@ std::chrono::duration<double> WheeledThreadPool::getMaxWait() {
     return maxWait;
 }
 
+bool WheeledThreadPool::isPoolThread() {
+    return poolThread;
+}
+
+void WheeledThreadPool::enableMetrics(bool enable) {
+    metricsEnabled.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<BSignals::SpokeMetricsSnapshot> WheeledThreadPool::getMetrics() {
+    std::vector<BSignals::SpokeMetricsSnapshot> spokes(nThreads);
+    for (uint32_t i=0; i<nThreads; ++i){
+        spokes[i].dequeued = spokeCounters[i].dequeued.load(std::memory_order_relaxed);
+        spokes[i].enqueued = spokeCounters[i].enqueued.load(std::memory_order_relaxed);
+        spokes[i].depth = (spokes[i].enqueued > spokes[i].dequeued ? spokes[i].enqueued - spokes[i].dequeued : 0);
+    }
+    return spokes;
+}
+
 void WheeledThreadPool::queueListener(uint32_t index) {
+    poolThread = true;
     auto &spoke = threadPooledFunctions.getSpoke(index);
     std::function<void()> func;
     std::chrono::duration<double> waitTime = std::chrono::nanoseconds(1);
@@ -70,9 +108,16 @@ void WheeledThreadPool::queueListener(uint32_t index) {
     auto wrapIncrementer = [wrap](uint32_t i){return (i+1 == wrap ? 0 : i+1);};
     
     while (isStarted){
-        if (spoke.dequeue(func)){
-            spoke.transferMaxToCache();
+        //move waiting tasks into the cache first so that they can be stolen
+        //while this thread works through its batch. Tasks are taken one at a
+        //time, so that those behind a slow task are still free to be stolen
+        spoke.transferMaxToCache();
+        uint32_t ran = 0;
+        while (ran < batchSize && spoke.dequeue(func)){
+            ++ran;
             if (func) func();
+        }
+        if (ran){
             waitTime = std::chrono::nanoseconds(1);
         }
         else{
@@ -84,7 +129,11 @@ void WheeledThreadPool::queueListener(uint32_t index) {
                 }
             }
             if (found){
-                if (func) func();
+                if (func){
+                    Tracer::setRunningStolenTask(true);
+                    func();
+                    Tracer::setRunningStolenTask(false);
+                }
                 waitTime = std::chrono::nanoseconds(1);
             }
             else{
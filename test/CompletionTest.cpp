@@ -0,0 +1,198 @@
+#include "CompletionTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/CompletionHandle.h"
+#include "BSignals/details/CompletionState.h"
+
+using BSignals::Signal;
+using BSignals::ExecutorScheme;
+using BSignals::CompletionHandle;
+using BSignals::details::CompletionState;
+using BSignals::details::CompletionToken;
+using std::cout;
+using std::endl;
+using std::thread;
+using std::atomic;
+using std::vector;
+
+void CompletionTest::SetUp() {
+
+}
+
+void CompletionTest::TearDown() {
+
+}
+
+TEST_F(CompletionTest, AllSchemes){
+    const vector<ExecutorScheme> schemes{
+        ExecutorScheme::SYNCHRONOUS,
+        ExecutorScheme::DEFERRED_SYNCHRONOUS,
+        ExecutorScheme::DEFERRED_BUFFERED,
+        ExecutorScheme::ASYNCHRONOUS,
+        ExecutorScheme::STRAND,
+        ExecutorScheme::SINGLE_PRODUCER_STRAND,
+        ExecutorScheme::THREAD_POOLED,
+        ExecutorScheme::KEYED_STRAND,
+        ExecutorScheme::PARALLEL_SYNCHRONOUS
+    };
+    for (auto guard : {false, true}){
+        for (auto scheme : schemes){
+            Signal<uint32_t> signal(guard);
+            atomic<uint32_t> sum{0};
+            for (uint32_t i=0; i<3; ++i){
+                signal.connectSlot(scheme, [&sum](uint32_t x){
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    sum += x;
+                });
+            }
+            CompletionHandle handle = signal.emitAsync(2);
+            bool deferred = (scheme == ExecutorScheme::DEFERRED_SYNCHRONOUS || scheme == ExecutorScheme::DEFERRED_BUFFERED);
+            if (deferred){
+                ASSERT_FALSE(handle.isComplete());
+                ASSERT_FALSE(handle.waitFor(std::chrono::milliseconds(1)));
+                signal.invokeDeferred();
+            }
+            handle.wait();
+            ASSERT_TRUE(handle.isComplete());
+            ASSERT_EQ(sum, 6u);
+        }
+    }
+}
+
+TEST_F(CompletionTest, NoSlots){
+    Signal<uint32_t> signal;
+    CompletionHandle handle = signal.emitAsync(1);
+    ASSERT_TRUE(handle.isComplete());
+    CompletionHandle empty;
+    ASSERT_TRUE(empty.isComplete());
+    empty.wait();
+}
+
+TEST_F(CompletionTest, Continuation){
+    Signal<uint32_t> signal;
+    atomic<uint32_t> sum{0};
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [&sum](uint32_t x){
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        sum += x;
+    });
+    signal.connectSlot(ExecutorScheme::STRAND, [&sum](uint32_t x){
+        sum += x;
+    });
+    //registered before completion, runs on the completing thread
+    atomic<uint32_t> seen{0};
+    atomic<bool> ran{false};
+    CompletionHandle handle = signal.emitAsync(1);
+    handle.then([&](){
+        seen = sum.load();
+        ran = true;
+    });
+    handle.wait();
+    while (!ran) std::this_thread::yield();
+    ASSERT_EQ(seen, 2u);
+
+    //registered after completion, runs immediately
+    bool ranInline = false;
+    handle.then([&ranInline](){ranInline = true;});
+    ASSERT_TRUE(ranInline);
+}
+
+TEST_F(CompletionTest, DiscardedEmissionsComplete){
+    //disconnected before the deferred queue is drained
+    {
+        Signal<uint32_t> signal;
+        atomic<uint32_t> counter{0};
+        int id = signal.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [&counter](uint32_t){++counter;});
+        CompletionHandle handle = signal.emitAsync(1);
+        ASSERT_FALSE(handle.isComplete());
+        signal.disconnectSlot(id);
+        signal.invokeDeferred();
+        ASSERT_TRUE(handle.isComplete());
+        ASSERT_EQ(counter, 0u);
+    }
+    //buffered emissions discarded by disconnection
+    {
+        Signal<uint32_t> signal;
+        int id = signal.connectSlot(ExecutorScheme::DEFERRED_BUFFERED, [](uint32_t){});
+        CompletionHandle handle = signal.emitAsync(1);
+        ASSERT_FALSE(handle.isComplete());
+        signal.disconnectSlot(id);
+        ASSERT_TRUE(handle.isComplete());
+    }
+    //strand torn down with emissions still queued
+    {
+        Signal<uint32_t> signal;
+        int id = signal.connectSlot(ExecutorScheme::STRAND, [](uint32_t){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        vector<CompletionHandle> handles;
+        for (uint32_t i=0; i<100; ++i){
+            handles.push_back(signal.emitAsync(i));
+        }
+        signal.disconnectSlot(id);
+        for (auto &handle : handles){
+            ASSERT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+        }
+    }
+    //handle outlives the signal
+    CompletionHandle handle;
+    {
+        Signal<uint32_t> signal;
+        signal.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [](uint32_t){});
+        handle = signal.emitAsync(1);
+    }
+    ASSERT_TRUE(handle.isComplete());
+}
+
+TEST_F(CompletionTest, HandleDroppedBeforeCompletion){
+    Signal<uint32_t> signal;
+    atomic<uint32_t> counter{0};
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [&counter](uint32_t){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++counter;
+    });
+    const uint32_t nEmissions = 1000;
+    for (uint32_t i=0; i<nEmissions; ++i){
+        signal.emitAsync(i);
+    }
+    //the last emission is tracked, pool threads complete the rest unobserved
+    while (counter != nEmissions) std::this_thread::yield();
+    signal.emitAsync(0).wait();
+}
+
+TEST_F(CompletionTest, CopiedTokensEachHoldTheEmission){
+    CompletionState* state = CompletionState::acquire();
+    CompletionHandle handle(state);
+    std::function<void()> task;
+    {
+        CompletionToken token(state);
+        task = [token](){};
+    }
+    //a copy of the task (and its token) keeps the emission pending
+    std::function<void()> copy = task;
+    task = nullptr;
+    ASSERT_FALSE(handle.isComplete());
+    copy = nullptr;
+    ASSERT_TRUE(handle.isComplete());
+}
+
+TEST_F(CompletionTest, PooledStateDoesNotAllocate){
+    Signal<uint32_t> signal;
+    uint32_t sum = 0;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){sum += x;});
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){sum += x;});
+    //warm the state pool
+    signal.emitAsync(0).wait();
+    uint64_t allocated = CompletionState::getAllocatedCount();
+    for (uint32_t i=0; i<10000; ++i){
+        CompletionHandle handle = signal.emitAsync(1);
+        handle.wait();
+    }
+    ASSERT_EQ(allocated, CompletionState::getAllocatedCount());
+    ASSERT_EQ(sum, 20000u);
+}
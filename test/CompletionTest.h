@@ -0,0 +1,20 @@
+/* 
+ * File:   CompletionTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 9:10 PM
+ */
+
+#ifndef BSIGNALS_COMPLETIONTEST_H
+#define BSIGNALS_COMPLETIONTEST_H
+
+#include <gtest/gtest.h>
+
+class CompletionTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_COMPLETIONTEST_H */
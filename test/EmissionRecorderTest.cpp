@@ -0,0 +1,157 @@
+#include "EmissionRecorderTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/EmissionRecorder.hpp"
+#include "BSignals/EmissionReplayer.hpp"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::Signal;
+using BSignals::EmissionRecorder;
+using BSignals::EmissionReplayer;
+using BSignals::ExecutorScheme;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+using std::string;
+
+namespace{
+string tracePath(const string& test){
+    return "/tmp/BSignalsTest." + test + "." + std::to_string(getpid()) + ".trace";
+}
+}
+
+void EmissionRecorderTest::SetUp() {
+
+}
+
+void EmissionRecorderTest::TearDown() {
+
+}
+
+TEST_F(EmissionRecorderTest, RecordAndReplay){
+    const string path = tracePath("RecordAndReplay");
+    const uint32_t nThreads = 4;
+    const uint32_t nEmissions = 10000;
+    {
+        Signal<uint32_t, uint32_t> signal(true);
+        EmissionRecorder<uint32_t, uint32_t> recorder(signal, path);
+        vector<std::thread> threads;
+        for (uint32_t t=0; t<nThreads; ++t){
+            threads.emplace_back([&signal, t, nEmissions](){
+                for (uint32_t i=0; i<nEmissions; ++i) signal.emitSignal(t, i);
+            });
+        }
+        for (auto &t : threads) t.join();
+        ASSERT_EQ(0u, recorder.getDroppedCount());
+    }
+    EmissionReplayer<uint32_t, uint32_t> replayer(path);
+    ASSERT_EQ(nThreads*nEmissions, replayer.getEmissionCount());
+    Signal<uint32_t, uint32_t> replayed;
+    vector<vector<uint32_t>> received(nThreads);
+    replayed.connectSlot(ExecutorScheme::SYNCHRONOUS, [&received](uint32_t thread, uint32_t sequence){
+        received[thread].push_back(sequence);
+    });
+    auto statistics = replayer.replay(replayed, 0);
+    ASSERT_EQ(nThreads*nEmissions, statistics.emissions);
+    //each thread's emissions are replayed in the order they were made
+    for (auto &r : received){
+        ASSERT_EQ(nEmissions, r.size());
+        for (uint32_t i=0; i<nEmissions; ++i){
+            ASSERT_EQ(i, r[i]);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(EmissionRecorderTest, ReplaySpeed){
+    const string path = tracePath("ReplaySpeed");
+    {
+        Signal<uint32_t> signal;
+        EmissionRecorder<uint32_t> recorder(signal, path);
+        for (uint32_t i=0; i<5; ++i){
+            signal.emitSignal(i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    EmissionReplayer<uint32_t> replayer(path);
+    ASSERT_EQ(5u, replayer.getEmissionCount());
+    ASSERT_GE(replayer.getDuration(), std::chrono::milliseconds(40));
+    uint32_t count = 0;
+    auto counter = [&count](uint32_t){++count;};
+    for (double speed : {1.0, 2.0, 0.0}){
+        auto statistics = replayer.replay(counter, speed);
+        if (speed > 0){
+            ASSERT_GE(statistics.elapsed, std::chrono::duration_cast<std::chrono::nanoseconds>(replayer.getDuration()/speed));
+        }
+        cout << "Speed " << speed << ": replayed in " << statistics.elapsed.count() << "ns, " <<
+                "max lateness " << statistics.maxLateness.count() << "ns" << endl;
+    }
+    ASSERT_EQ(15u, count);
+    std::remove(path.c_str());
+}
+
+TEST_F(EmissionRecorderTest, DropsWhenFull){
+    const string path = tracePath("DropsWhenFull");
+    {
+        Signal<uint64_t> signal;
+        //room for a single chunk of records
+        EmissionRecorder<uint64_t> recorder(signal, path, 1);
+        for (uint64_t i=0; i<2000; ++i) signal.emitSignal(i);
+        ASSERT_EQ(2000u - 1024u, recorder.getDroppedCount());
+    }
+    EmissionReplayer<uint64_t> replayer(path);
+    ASSERT_EQ(1024u, replayer.getEmissionCount());
+    ASSERT_EQ(2000u - 1024u, replayer.getDroppedCount());
+    uint64_t expected = 0;
+    replayer.replay([&expected](uint64_t x){
+        ASSERT_EQ(expected++, x);
+    }, 0);
+    std::remove(path.c_str());
+}
+
+TEST_F(EmissionRecorderTest, DifferentArguments){
+    const string path = tracePath("DifferentArguments");
+    {
+        Signal<uint32_t> signal;
+        EmissionRecorder<uint32_t> recorder(signal, path);
+        signal.emitSignal(1);
+    }
+    ASSERT_THROW(EmissionReplayer<double>{path}, std::invalid_argument);
+    std::remove(path.c_str());
+    ASSERT_THROW(EmissionReplayer<uint32_t>{path}, std::system_error);
+}
+
+TEST_F(EmissionRecorderTest, RecordingOverhead){
+    const string path = tracePath("RecordingOverhead");
+    const uint32_t nEmissions = 1000000;
+    for (bool recording : {false, true}){
+        Signal<uint32_t, double> signal;
+        std::unique_ptr<EmissionRecorder<uint32_t, double>> recorder;
+        if (recording) recorder.reset(new EmissionRecorder<uint32_t, double>(signal, path));
+        uint64_t sum = 0;
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x, double){
+            sum += x;
+        });
+        BasicTimer bt;
+        bt.start();
+        for (uint32_t i=0; i<nEmissions; ++i){
+            signal.emitSignal(i, 0.5);
+        }
+        bt.stop();
+        cout << (recording ? "Recording" : "Not recording") << " average emission time: " <<
+                bt.getElapsedNanoseconds()/nEmissions << "ns" << endl;
+    }
+    std::remove(path.c_str());
+}
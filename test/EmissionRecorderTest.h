@@ -0,0 +1,20 @@
+/* 
+ * File:   EmissionRecorderTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 4:20 AM
+ */
+
+#ifndef BSIGNALS_EMISSIONRECORDERTEST_H
+#define BSIGNALS_EMISSIONRECORDERTEST_H
+
+#include <gtest/gtest.h>
+
+class EmissionRecorderTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_EMISSIONRECORDERTEST_H */
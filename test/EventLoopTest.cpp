@@ -0,0 +1,154 @@
+#include "EventLoopTest.h"
+#include <iostream>
+#include <list>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+
+#ifdef LINUX
+#include <poll.h>
+#endif
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/EventLoop.h"
+
+using BSignals::Signal;
+using BSignals::EventLoop;
+using std::cout;
+using std::endl;
+using std::list;
+using std::thread;
+using std::atomic;
+using std::vector;
+
+void EventLoopTest::SetUp() {
+
+}
+
+void EventLoopTest::TearDown() {
+
+}
+
+namespace{
+#ifdef LINUX
+bool isReadable(int fd){
+    pollfd pfd{fd, POLLIN, 0};
+    return (poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN));
+}
+#endif
+}
+
+TEST_F(EventLoopTest, EmissionOrderAcrossSignals){
+    EventLoop loop;
+    const uint32_t nSignals = 200;
+    vector<std::unique_ptr<Signal<uint32_t>>> signals;
+    vector<uint32_t> order;
+    for (uint32_t i=0; i<nSignals; ++i){
+        signals.emplace_back(new Signal<uint32_t>);
+        signals.back()->connectSlot(loop, [&order](uint32_t x){
+            order.push_back(x);
+        });
+    }
+    //emit in reverse signal order, so that order can't come from connection order
+    uint32_t seq = 0;
+    for (uint32_t round=0; round<10; ++round){
+        for (uint32_t i=nSignals; i-- > 0;){
+            signals[i]->emitSignal(seq++);
+        }
+    }
+    ASSERT_TRUE(order.empty());
+    ASSERT_TRUE(loop.hasPending());
+    ASSERT_EQ(seq, loop.runPending());
+    ASSERT_FALSE(loop.hasPending());
+    ASSERT_EQ(seq, order.size());
+    for (uint32_t i=0; i<seq; ++i) ASSERT_EQ(i, order[i]);
+    ASSERT_EQ(0u, loop.runPending());
+}
+
+TEST_F(EventLoopTest, EventFd){
+    EventLoop loop;
+#ifdef LINUX
+    ASSERT_GE(loop.getEventFd(), 0);
+    Signal<int> signal;
+    int sum = 0;
+    signal.connectSlot(loop, [&sum](int x){
+        sum += x;
+    });
+    ASSERT_FALSE(isReadable(loop.getEventFd()));
+    signal.emitSignal(1);
+    signal.emitSignal(2);
+    ASSERT_TRUE(isReadable(loop.getEventFd()));
+    loop.runPending();
+    ASSERT_EQ(3, sum);
+    ASSERT_FALSE(isReadable(loop.getEventFd()));
+    
+    //posting from another thread wakes a sleeping loop
+    thread emitter([&signal](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        signal.emitSignal(4);
+    });
+    pollfd pfd{loop.getEventFd(), POLLIN, 0};
+    ASSERT_EQ(1, poll(&pfd, 1, 5000));
+    emitter.join();
+    ASSERT_EQ(1u, loop.runPending());
+    ASSERT_EQ(7, sum);
+#else
+    ASSERT_EQ(-1, loop.getEventFd());
+#endif
+}
+
+TEST_F(EventLoopTest, DisconnectCancelsPending){
+    EventLoop loop;
+    for (auto threadSafe : {false, true}){
+        int invoked = 0;
+        {
+            Signal<int> signal(threadSafe);
+            int id = signal.connectSlot(loop, [&invoked](int){
+                ++invoked;
+            });
+            signal.emitSignal(1);
+            ASSERT_EQ(1u, loop.runPending());
+            ASSERT_EQ(1, invoked);
+            
+            signal.emitSignal(1);
+            signal.disconnectSlot(id);
+            loop.runPending();
+            ASSERT_EQ(1, invoked);
+            
+            signal.connectSlot(loop, [&invoked](int){
+                ++invoked;
+            });
+            signal.emitSignal(1);
+        }
+        //the signal has been destroyed with an emission still posted
+        loop.runPending();
+        ASSERT_EQ(1, invoked);
+    }
+}
+
+TEST_F(EventLoopTest, ConcurrentEmitters){
+    EventLoop loop;
+    const uint32_t nEmitters = 4;
+    const uint32_t nEmissions = 100000;
+    Signal<uint32_t, uint32_t> signal;
+    vector<uint32_t> lastSeen(nEmitters, 0);
+    atomic<uint32_t> received{0};
+    bool ordered = true;
+    signal.connectSlot(loop, [&](uint32_t emitter, uint32_t seq){
+        ordered &= (seq == lastSeen[emitter] + 1);
+        lastSeen[emitter] = seq;
+        ++received;
+    });
+    list<thread> emitters;
+    for (uint32_t i=0; i<nEmitters; ++i){
+        emitters.emplace_back([&signal, i](){
+            for (uint32_t j=1; j<=nEmissions; ++j) signal.emitSignal(i, j);
+        });
+    }
+    while (received != nEmitters*nEmissions){
+        if (!loop.runPending()) std::this_thread::yield();
+    }
+    for (auto &t : emitters) t.join();
+    ASSERT_TRUE(ordered);
+}
@@ -0,0 +1,20 @@
+/* 
+ * File:   EventLoopTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 5:40 PM
+ */
+
+#ifndef BSIGNALS_EVENTLOOPTEST_H
+#define BSIGNALS_EVENTLOOPTEST_H
+
+#include <gtest/gtest.h>
+
+class EventLoopTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_EVENTLOOPTEST_H */
@@ -0,0 +1,69 @@
+#include "InstrumentationTest.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <type_traits>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/Instrumentation.h"
+
+using BSignals::Signal;
+using BSignals::BasicSignal;
+using BSignals::ExecutorScheme;
+using BSignals::NoInstrumentation;
+using BSignals::CountingInstrumentation;
+using BSignals::TimingInstrumentation;
+using std::atomic;
+using std::vector;
+
+static_assert(std::is_same<Signal<int>, BasicSignal<NoInstrumentation, int>>::value, "Signal is uninstrumented");
+static_assert(std::is_empty<NoInstrumentation>::value, "no-op policy has no state");
+static_assert(sizeof(BSignals::details::Emission<uint64_t>) + 2*sizeof(uint64_t) == sizeof(BSignals::details::InstrumentedEmission<uint64_t>),
+    "only the emissions of instrumented slots carry a timestamp and trace id");
+
+void InstrumentationTest::SetUp() {
+
+}
+
+void InstrumentationTest::TearDown() {
+
+}
+
+TEST_F(InstrumentationTest, Counting){
+    BasicSignal<CountingInstrumentation, uint32_t> signal(true);
+    atomic<uint32_t> count{0};
+    for (uint32_t i=0; i<3; ++i){
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&count](uint32_t){++count;});
+    }
+    signal.connectSlot(ExecutorScheme::PARALLEL_SYNCHRONOUS, [&count](uint32_t){++count;});
+    vector<std::thread> threads;
+    for (uint32_t t=0; t<4; ++t){
+        threads.emplace_back([&signal](){
+            for (uint32_t i=0; i<1000; ++i) signal.emitSignal(i);
+        });
+    }
+    for (auto &t : threads) t.join();
+    signal.emitAsync(0).wait();
+    ASSERT_EQ(4001u, signal.getInstrumentation().getEmissionCount());
+    ASSERT_EQ(4*4001u, signal.getInstrumentation().getDispatchCount());
+    ASSERT_EQ(4*4001u, count);
+}
+
+TEST_F(InstrumentationTest, Timing){
+    BasicSignal<TimingInstrumentation, uint32_t> signal;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    });
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){});
+    for (uint32_t i=0; i<20; ++i){
+        signal.emitSignal(i);
+    }
+    auto emitTime = signal.getInstrumentation().getEmitTime();
+    auto dispatchTime = signal.getInstrumentation().getDispatchTime();
+    ASSERT_EQ(20u, emitTime.count);
+    ASSERT_EQ(40u, dispatchTime.count);
+    ASSERT_GE(emitTime.getPercentile(0), 100000u);
+    //half of the dispatches were to the empty slot
+    ASSERT_LT(dispatchTime.getPercentile(25), 100000u);
+    ASSERT_GE(dispatchTime.getPercentile(75), 100000u);
+}
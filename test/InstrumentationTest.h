@@ -0,0 +1,20 @@
+/* 
+ * File:   InstrumentationTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 6:05 AM
+ */
+
+#ifndef BSIGNALS_INSTRUMENTATIONTEST_H
+#define BSIGNALS_INSTRUMENTATIONTEST_H
+
+#include <gtest/gtest.h>
+
+class InstrumentationTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_INSTRUMENTATIONTEST_H */
@@ -0,0 +1,202 @@
+#include "KeyedSignalTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/KeyedSignal.hpp"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::Signal;
+using BSignals::KeyedSignal;
+using BSignals::ExecutorScheme;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+using std::string;
+
+void KeyedSignalTest::SetUp() {
+
+}
+
+void KeyedSignalTest::TearDown() {
+
+}
+
+TEST_F(KeyedSignalTest, ExactKeys){
+    for (auto guard : {false, true}){
+        KeyedSignal<string, int> signal(guard);
+        int a = 0, b = 0, b2 = 0;
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, "a", [&a](int x){a += x;});
+        int bId = signal.connectSlot(ExecutorScheme::SYNCHRONOUS, "b", [&b](int x){b += x;});
+        signal.emitKeyed("a", 1);
+        signal.emitKeyed("b", 10);
+        signal.emitKeyed("c", 100);
+        //connected after b's route was compiled
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, "b", [&b2](int x){b2 += x;});
+        signal.emitKeyed("b", 10);
+        signal.disconnectSlot(bId);
+        signal.emitKeyed("b", 10);
+        ASSERT_EQ(a, 1);
+        ASSERT_EQ(b, 20);
+        ASSERT_EQ(b2, 20);
+    }
+}
+
+TEST_F(KeyedSignalTest, RangesAndPredicates){
+    KeyedSignal<uint32_t, uint32_t> signal;
+    vector<uint32_t> range, even, exact;
+    uint32_t predicateCalls = 0;
+    signal.connectRangeSlot(ExecutorScheme::SYNCHRONOUS, 10, 20, [&range](uint32_t x){range.push_back(x);});
+    int evenId = signal.connectPredicateSlot(ExecutorScheme::SYNCHRONOUS,
+        [&predicateCalls](const uint32_t& key){
+            ++predicateCalls;
+            return (key % 2 == 0);
+        },
+        [&even](uint32_t x){even.push_back(x);});
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, 15, [&exact](uint32_t x){exact.push_back(x);});
+    for (uint32_t round=0; round<10; ++round){
+        for (uint32_t key : {9u, 10u, 15u, 20u, 21u}){
+            signal.emitKeyed(key, key);
+        }
+    }
+    ASSERT_EQ(range.size(), 30u);
+    ASSERT_EQ(even.size(), 20u);
+    ASSERT_EQ(exact.size(), 10u);
+    //once per distinct key, not per emission
+    ASSERT_EQ(predicateCalls, 5u);
+    
+    signal.disconnectSlot(evenId);
+    signal.emitKeyed(10, 10);
+    ASSERT_EQ(even.size(), 20u);
+    ASSERT_EQ(range.size(), 31u);
+}
+
+TEST_F(KeyedSignalTest, QueuedSchemes){
+    KeyedSignal<uint32_t, uint32_t> signal(true);
+    atomic<uint32_t> sum{0};
+    signal.connectSlot(ExecutorScheme::STRAND, 1, [&sum](uint32_t x){sum += x;});
+    signal.connectRangeSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, 0, 5, [&sum](uint32_t x){sum += x;});
+    std::thread emitter([&](){
+        for (uint32_t i=0; i<1000; ++i) signal.emitKeyed(i % 10, 1);
+    });
+    emitter.join();
+    signal.invokeDeferred();
+    //100 strand emissions for key 1, 600 deferred emissions for keys 0-5
+    while (sum != 700) std::this_thread::yield();
+}
+
+TEST_F(KeyedSignalTest, KeyedVersusFiltered){
+    const uint32_t nKeys = 1000;
+    const uint32_t nEmissions = 100000;
+    uint64_t sum = 0;
+    
+    //every slot runs and discards the emissions that aren't for its key
+    Signal<uint32_t, uint32_t> filtered;
+    KeyedSignal<uint32_t, uint32_t> keyed;
+    for (uint32_t k=0; k<nKeys; ++k){
+        filtered.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum, k](uint32_t key, uint32_t x){
+            if (key == k) sum += x;
+        });
+        keyed.connectSlot(ExecutorScheme::SYNCHRONOUS, k, [&sum](uint32_t x){
+            sum += x;
+        });
+    }
+    BasicTimer timer;
+    timer.start();
+    for (uint32_t i=0; i<nEmissions; ++i){
+        filtered.emitSignal(i % nKeys, 1);
+    }
+    timer.stop();
+    double filteredTime = timer.getElapsedNanoseconds();
+    timer.start();
+    for (uint32_t i=0; i<nEmissions; ++i){
+        keyed.emitKeyed(i % nKeys, 1);
+    }
+    timer.stop();
+    double keyedTime = timer.getElapsedNanoseconds();
+    cout << "Filtered in slot: " << filteredTime/nEmissions << "ns per emission" << endl;
+    cout << "Keyed dispatch: " << keyedTime/nEmissions << "ns per emission" << endl;
+    ASSERT_EQ(sum, 2u*nEmissions);
+}
+
+TEST_F(KeyedSignalTest, ReentrantEmission){
+    KeyedSignal<uint32_t, uint32_t> signal(true);
+    uint32_t inner = 0, late = 0;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, 2, [&inner](uint32_t x){inner += x;});
+    //emits a new key, and subscribes to another, from within a slot
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, 1, [&](uint32_t x){
+        signal.emitKeyed(2, x);
+        if (late == 0) signal.connectSlot(ExecutorScheme::SYNCHRONOUS, 3, [&late](uint32_t y){late += y;});
+    });
+    for (uint32_t i=0; i<10; ++i){
+        signal.emitKeyed(1, 1);
+        signal.emitKeyed(3, 1);
+    }
+    ASSERT_EQ(inner, 10u);
+    ASSERT_EQ(late, 10u);
+}
+
+TEST_F(KeyedSignalTest, ConcurrentNewKeys){
+    //emissions of new keys from several threads, without thread safety
+    KeyedSignal<uint32_t, uint32_t> signal;
+    atomic<uint32_t> predicateCalls{0};
+    atomic<uint64_t> sum{0};
+    signal.connectRangeSlot(ExecutorScheme::SYNCHRONOUS, 0, UINT32_MAX, [&sum](uint32_t x){sum += x;});
+    signal.connectPredicateSlot(ExecutorScheme::SYNCHRONOUS,
+        [&predicateCalls](const uint32_t& key){
+            ++predicateCalls;
+            return (key % 2 == 0);
+        },
+        [&sum](uint32_t x){sum += x;});
+    const uint32_t nThreads = 4;
+    const uint32_t nKeys = 20000;
+    vector<std::thread> emitters;
+    for (uint32_t t=0; t<nThreads; ++t){
+        emitters.emplace_back([&signal, t](){
+            for (uint32_t i=0; i<nKeys; ++i) signal.emitKeyed(t*nKeys + i, 1);
+        });
+    }
+    for (auto &e : emitters) e.join();
+    ASSERT_EQ(sum, (uint64_t)nThreads*nKeys*3/2);
+    //the route cache is bounded, so re-emitting the first keys evaluates them again
+    uint32_t before = predicateCalls;
+    for (uint32_t i=0; i<100; ++i) signal.emitKeyed(i, 1);
+    ASSERT_GT(predicateCalls, before);
+}
+
+TEST_F(KeyedSignalTest, ConcurrentSubscriptionChanges){
+    //routes hold the slots themselves, so slots disconnected while they're
+    //being emitted to must outlive the emissions
+    KeyedSignal<uint32_t, uint32_t> signal(true);
+    atomic<uint32_t> kept{0};
+    atomic<uint32_t> churned{0};
+    const uint32_t nKeys = 4;
+    for (uint32_t k=0; k<nKeys; ++k){
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, k, [&kept](uint32_t x){kept += x;});
+    }
+    atomic<bool> stop{false};
+    std::thread churner([&](){
+        while (!stop){
+            int id = signal.connectSlot(ExecutorScheme::SYNCHRONOUS, churned % nKeys, [&churned](uint32_t){++churned;});
+            signal.disconnectSlot(id);
+        }
+    });
+    const uint32_t nThreads = 2;
+    const uint32_t nEmissions = 20000;
+    vector<std::thread> emitters;
+    for (uint32_t t=0; t<nThreads; ++t){
+        emitters.emplace_back([&signal](){
+            for (uint32_t i=0; i<nEmissions; ++i) signal.emitKeyed(i % nKeys, 1);
+        });
+    }
+    for (auto &e : emitters) e.join();
+    stop = true;
+    churner.join();
+    ASSERT_EQ(kept, nThreads*nEmissions);
+}
+
@@ -0,0 +1,20 @@
+/* 
+ * File:   KeyedSignalTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 12:45 AM
+ */
+
+#ifndef BSIGNALS_KEYEDSIGNALTEST_H
+#define BSIGNALS_KEYEDSIGNALTEST_H
+
+#include <gtest/gtest.h>
+
+class KeyedSignalTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_KEYEDSIGNALTEST_H */
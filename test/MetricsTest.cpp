@@ -0,0 +1,203 @@
+#include "MetricsTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/Metrics.h"
+#include "BSignals/details/LatencyHistogram.h"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::Signal;
+using BSignals::ExecutorScheme;
+using BSignals::HistogramSnapshot;
+using BSignals::SlotMetricsSnapshot;
+using BSignals::details::LatencyHistogram;
+using BSignals::details::ShardedCounter;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+
+void MetricsTest::SetUp() {
+
+}
+
+void MetricsTest::TearDown() {
+
+}
+
+TEST_F(MetricsTest, HistogramBuckets){
+    for (uint64_t value : vector<uint64_t>{0, 1, 7, 8, 9, 15, 16, 1000, 123456789, 1ull << 40, UINT64_MAX}){
+        uint32_t bucket = LatencyHistogram::getBucket(value);
+        ASSERT_LT(bucket, LatencyHistogram::nBuckets);
+        ASSERT_LE(HistogramSnapshot::getBucketLowerBound(bucket), value);
+        ASSERT_GE(HistogramSnapshot::getBucketUpperBound(bucket), value);
+    }
+    //buckets are contiguous
+    for (uint32_t b=0; b+1<LatencyHistogram::nBuckets; ++b){
+        ASSERT_EQ(HistogramSnapshot::getBucketUpperBound(b) + 1, HistogramSnapshot::getBucketLowerBound(b + 1));
+    }
+}
+
+TEST_F(MetricsTest, HistogramPercentiles){
+    LatencyHistogram histogram;
+    vector<std::thread> threads;
+    //four threads each recording 1 to 10000
+    for (uint32_t t=0; t<4; ++t){
+        threads.emplace_back([&histogram](){
+            for (uint64_t i=1; i<=10000; ++i) histogram.record(i);
+        });
+    }
+    for (auto &t : threads) t.join();
+    HistogramSnapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(40000u, snapshot.count);
+    ASSERT_NEAR(5000.0, (double)snapshot.getPercentile(50), 5000*0.125);
+    ASSERT_NEAR(9900.0, (double)snapshot.getPercentile(99), 9900*0.125);
+    ASSERT_NEAR(5000.0, snapshot.getMean(), 5000*0.125);
+    ASSERT_GE(snapshot.getMax(), 10000u);
+    snapshot.merge(snapshot);
+    ASSERT_EQ(80000u, snapshot.count);
+}
+
+TEST_F(MetricsTest, ShardPerThread){
+    //more threads than any fixed shard count, several of them short lived
+    LatencyHistogram histogram;
+    ShardedCounter counter;
+    for (uint32_t round=0; round<4; ++round){
+        vector<std::thread> threads;
+        for (uint32_t t=0; t<40; ++t){
+            threads.emplace_back([&histogram, &counter](){
+                for (uint64_t i=1; i<=1000; ++i){
+                    histogram.record(i);
+                    counter.increment();
+                }
+            });
+        }
+        for (auto &t : threads) t.join();
+    }
+    ASSERT_EQ(160000u, histogram.snapshot().count);
+    ASSERT_EQ(160000u, counter.load());
+}
+
+TEST_F(MetricsTest, SlotMetrics){
+    const uint32_t nEmissions = 1000;
+    Signal<uint32_t> signal;
+    signal.enableMetrics();
+    atomic<uint32_t> count{0};
+    auto slot = [&count](uint32_t){
+        ++count;
+    };
+    int syncId = signal.connectSlot(ExecutorScheme::SYNCHRONOUS, slot);
+    int strandId = signal.connectSlot(ExecutorScheme::STRAND, slot);
+    int keyedId = signal.connectSlot(ExecutorScheme::KEYED_STRAND, slot);
+    for (uint32_t i=0; i<nEmissions; ++i){
+        signal.emitSignal(i);
+    }
+    BasicTimer bt;
+    bt.start();
+    while (count != 3*nEmissions && bt.getElapsedSeconds() < 10.0) std::this_thread::yield();
+    ASSERT_EQ(3*nEmissions, count);
+    auto metrics = signal.getMetrics();
+    ASSERT_EQ(3u, metrics.size());
+    for (auto const &m : metrics){
+        ASSERT_EQ(nEmissions, m.executionTime.count);
+        if (m.slotId == syncId){
+            ASSERT_EQ(ExecutorScheme::SYNCHRONOUS, m.scheme);
+            ASSERT_EQ(0u, m.enqueued);
+            ASSERT_EQ(0u, m.sojournTime.count);
+        }
+        else{
+            ASSERT_TRUE(m.slotId == strandId || m.slotId == keyedId);
+            ASSERT_EQ(nEmissions, m.enqueued);
+            ASSERT_EQ(nEmissions, m.dequeued);
+            ASSERT_EQ(0u, m.depth);
+            ASSERT_EQ(nEmissions, m.sojournTime.count);
+        }
+        cout << "Slot " << m.slotId << ": execution p50 " << m.executionTime.getPercentile(50) << "ns, p99 " <<
+                m.executionTime.getPercentile(99) << "ns, sojourn p50 " << m.sojournTime.getPercentile(50) << "ns" << endl;
+    }
+    signal.disconnectSlot(strandId);
+    ASSERT_EQ(2u, signal.getMetrics().size());
+}
+
+TEST_F(MetricsTest, QueueDepth){
+    Signal<uint32_t> signal;
+    signal.enableMetrics();
+    atomic<bool> release{false};
+    atomic<uint32_t> count{0};
+    signal.connectSlot(ExecutorScheme::STRAND, [&](uint32_t){
+        while (!release) std::this_thread::yield();
+        ++count;
+    });
+    for (uint32_t i=0; i<10; ++i){
+        signal.emitSignal(i);
+    }
+    //the first emission may have been dequeued, and be blocking the strand
+    uint64_t depth = signal.getMetrics().front().depth;
+    ASSERT_TRUE(depth == 9 || depth == 10);
+    release = true;
+    while (count != 10) std::this_thread::yield();
+    ASSERT_EQ(0u, signal.getMetrics().front().depth);
+}
+
+TEST_F(MetricsTest, UninstrumentedSlots){
+    Signal<uint32_t> signal;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){});
+    signal.enableMetrics();
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){});
+    signal.emitSignal(1);
+    //only slots connected after enableMetrics are instrumented
+    auto metrics = signal.getMetrics();
+    ASSERT_EQ(1u, metrics.size());
+    ASSERT_EQ(1u, metrics.front().executionTime.count);
+}
+
+TEST_F(MetricsTest, ThreadPoolSpokes){
+    BSignals::enableThreadPoolMetrics(true);
+    const uint32_t nEmissions = 1000;
+    //the tasks of instrumented slots are counted
+    Signal<uint32_t> signal;
+    signal.enableMetrics();
+    atomic<uint32_t> count{0};
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [&count](uint32_t){
+        ++count;
+    });
+    auto before = BSignals::getThreadPoolMetrics();
+    for (uint32_t i=0; i<nEmissions; ++i){
+        signal.emitSignal(i);
+    }
+    while (count != nEmissions) std::this_thread::yield();
+    auto after = BSignals::getThreadPoolMetrics();
+    BSignals::enableThreadPoolMetrics(false);
+    uint64_t enqueued = 0, dequeued = 0;
+    for (size_t i=0; i<after.size(); ++i){
+        enqueued += after[i].enqueued - before[i].enqueued;
+        dequeued += after[i].dequeued - before[i].dequeued;
+    }
+    ASSERT_GE(enqueued, nEmissions);
+    ASSERT_GE(dequeued, nEmissions);
+}
+
+TEST_F(MetricsTest, InstrumentationOverhead){
+    const uint32_t nEmissions = 1000000;
+    for (bool instrumented : {false, true}){
+        Signal<uint32_t> signal;
+        if (instrumented) signal.enableMetrics();
+        uint64_t sum = 0;
+        signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){
+            sum += x;
+        });
+        BasicTimer bt;
+        bt.start();
+        for (uint32_t i=0; i<nEmissions; ++i){
+            signal.emitSignal(i);
+        }
+        bt.stop();
+        cout << (instrumented ? "Instrumented" : "Uninstrumented") << " average emission time: " <<
+                bt.getElapsedNanoseconds()/nEmissions << "ns" << endl;
+    }
+}
@@ -0,0 +1,20 @@
+/* 
+ * File:   MetricsTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 5:20 AM
+ */
+
+#ifndef BSIGNALS_METRICSTEST_H
+#define BSIGNALS_METRICSTEST_H
+
+#include <gtest/gtest.h>
+
+class MetricsTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_METRICSTEST_H */
@@ -0,0 +1,143 @@
+#include "PipelineTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/Pipeline.hpp"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::Signal;
+using BSignals::BasicSignal;
+using BSignals::CountingInstrumentation;
+using BSignals::ExecutorScheme;
+using BSignals::filter;
+using BSignals::map;
+using BSignals::takeWhile;
+using BSignals::forwardTo;
+using BSignals::sink;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+using std::string;
+
+void PipelineTest::SetUp() {
+
+}
+
+void PipelineTest::TearDown() {
+
+}
+
+TEST_F(PipelineTest, FilterMapForward){
+    Signal<int> source;
+    Signal<string> destination;
+    vector<string> received;
+    destination.connectSlot(ExecutorScheme::SYNCHRONOUS, [&received](string s){
+        received.push_back(s);
+    });
+    source.connectSlot(ExecutorScheme::SYNCHRONOUS,
+        filter([](int x){return x % 2 == 0;})
+        | map([](int x){return x * 10;})
+        | map([](int x){return std::to_string(x);})
+        | forwardTo(destination));
+    for (int i=0; i<6; ++i){
+        source.emitSignal(i);
+    }
+    ASSERT_EQ(received, (vector<string>{"0", "20", "40"}));
+}
+
+TEST_F(PipelineTest, ForwardToInstrumentedSignal){
+    Signal<int> source;
+    BasicSignal<CountingInstrumentation, int> destination;
+    vector<int> received;
+    destination.connectSlot(ExecutorScheme::SYNCHRONOUS, [&received](int x){
+        received.push_back(x);
+    });
+    source.connectSlot(ExecutorScheme::SYNCHRONOUS, map([](int x){return x + 1;}) | forwardTo(destination));
+    for (int i=0; i<3; ++i){
+        source.emitSignal(i);
+    }
+    ASSERT_EQ(received, (vector<int>{1, 2, 3}));
+    ASSERT_EQ(3u, destination.getInstrumentation().getEmissionCount());
+}
+
+TEST_F(PipelineTest, MultipleArguments){
+    Signal<int, int> source;
+    vector<int> received;
+    source.connectSlot(ExecutorScheme::SYNCHRONOUS,
+        filter([](int a, int b){return a < b;})
+        | map([](int a, int b){return a + b;})
+        | sink([&received](int x){received.push_back(x);}));
+    source.emitSignal(1, 2);
+    source.emitSignal(2, 1);
+    source.emitSignal(3, 4);
+    ASSERT_EQ(received, (vector<int>{3, 7}));
+}
+
+TEST_F(PipelineTest, TakeWhile){
+    Signal<int> source;
+    vector<int> received;
+    //a partial pipeline can be built up in pieces before terminating it
+    auto stages = map([](int x){return x + 1;}) | takeWhile([](int x){return x < 4;});
+    source.connectSlot(ExecutorScheme::SYNCHRONOUS, stages | sink([&received](int x){received.push_back(x);}));
+    for (int i : {0, 1, 2, 3, 0, 1}){
+        source.emitSignal(i);
+    }
+    ASSERT_EQ(received, (vector<int>{1, 2, 3}));
+}
+
+TEST_F(PipelineTest, QueuedScheme){
+    Signal<int> source;
+    Signal<int> destination;
+    atomic<int> sum{0};
+    atomic<int> count{0};
+    destination.connectSlot(ExecutorScheme::SYNCHRONOUS, [&](int x){
+        sum += x;
+        ++count;
+    });
+    //the whole chain runs on the strand, as a single queued invocation
+    source.connectSlot(ExecutorScheme::STRAND,
+        filter([](int x){return x > 0;}) | map([](int x){return -x;}) | forwardTo(destination));
+    for (int i=-100; i<=100; ++i){
+        source.emitSignal(i);
+    }
+    while (count != 100) std::this_thread::yield();
+    ASSERT_EQ(sum, -5050);
+}
+
+TEST_F(PipelineTest, FusedVersusChained){
+    const uint32_t nEmissions = 1000000;
+    volatile int result = 0;
+    
+    //each stage is its own signal
+    Signal<int> s1, s2, s3;
+    s1.connectSlot(ExecutorScheme::SYNCHRONOUS, [&s2](int x){if (x & 1) s2.emitSignal(x);});
+    s2.connectSlot(ExecutorScheme::SYNCHRONOUS, [&s3](int x){s3.emitSignal(x * 3);});
+    s3.connectSlot(ExecutorScheme::SYNCHRONOUS, [&result](int x){result = x;});
+    
+    //the same stages fused into a single slot
+    Signal<int> fused;
+    fused.connectSlot(ExecutorScheme::SYNCHRONOUS,
+        filter([](int x){return (x & 1) != 0;})
+        | map([](int x){return x * 3;})
+        | sink([&result](int x){result = x;}));
+    
+    BasicTimer timer;
+    timer.start();
+    for (uint32_t i=0; i<nEmissions; ++i) s1.emitSignal(i);
+    timer.stop();
+    double chainedTime = timer.getElapsedNanoseconds();
+    timer.start();
+    for (uint32_t i=0; i<nEmissions; ++i) fused.emitSignal(i);
+    timer.stop();
+    double fusedTime = timer.getElapsedNanoseconds();
+    cout << "Chained signals: " << chainedTime/nEmissions << "ns per emission" << endl;
+    cout << "Fused pipeline: " << fusedTime/nEmissions << "ns per emission" << endl;
+    ASSERT_EQ(result, (int)(nEmissions - 1) * 3);
+}
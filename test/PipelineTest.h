@@ -0,0 +1,20 @@
+/* 
+ * File:   PipelineTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 10:05 PM
+ */
+
+#ifndef BSIGNALS_PIPELINETEST_H
+#define BSIGNALS_PIPELINETEST_H
+
+#include <gtest/gtest.h>
+
+class PipelineTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_PIPELINETEST_H */
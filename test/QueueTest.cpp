@@ -0,0 +1,349 @@
+#include "QueueTest.h"
+#include <list>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "BSignals/details/ContiguousMPMCQueue.hpp"
+#include "BSignals/details/DynamicMPMCQueue.hpp"
+#include "BSignals/details/SPSCQueue.hpp"
+#include "BSignals/details/MPSCQueue.hpp"
+
+using BSignals::details::ContiguousMPMCQueue;
+using BSignals::details::DynamicMPMCQueue;
+using BSignals::details::MPMCLayout;
+using BSignals::details::SPSCQueue;
+using BSignals::details::MPSCQueue;
+using std::list;
+using std::thread;
+using std::atomic;
+
+void QueueTest::SetUp() {
+
+}
+
+void QueueTest::TearDown() {
+
+}
+
+template <MPMCLayout L>
+void checkDynamicQueueOrdering(){
+    DynamicMPMCQueue<uint32_t, L> queue(64);
+    uint32_t x;
+    for (uint32_t round = 0; round < 4; ++round){
+        for (uint32_t i=0; i<64; ++i) ASSERT_TRUE(queue.enqueue(round*64 + i));
+        ASSERT_FALSE(queue.enqueue(0));
+        for (uint32_t i=0; i<64; ++i){
+            ASSERT_TRUE(queue.dequeue(x));
+            ASSERT_EQ(round*64 + i, x);
+        }
+        ASSERT_FALSE(queue.dequeue(x));
+    }
+}
+
+TEST_F(QueueTest, DynamicMPMCQueueLayouts){
+    checkDynamicQueueOrdering<MPMCLayout::COMPACT>();
+    checkDynamicQueueOrdering<MPMCLayout::PADDED>();
+    checkDynamicQueueOrdering<MPMCLayout::SCRAMBLED>();
+    ASSERT_THROW(DynamicMPMCQueue<uint32_t> queue(100), std::invalid_argument);
+}
+
+TEST_F(QueueTest, DynamicMPMCQueueBulk){
+    DynamicMPMCQueue<uint32_t, MPMCLayout::SCRAMBLED> queue(32);
+    uint32_t in[48], out[48];
+    for (uint32_t i=0; i<48; ++i) in[i] = i;
+    
+    ASSERT_EQ(20u, queue.enqueue_n(in, 20));
+    ASSERT_EQ(12u, queue.enqueue_n(in+20, 28));
+    ASSERT_EQ(0u, queue.enqueue_n(in+32, 16));
+    ASSERT_EQ(5u, queue.dequeue_n(out, 5));
+    ASSERT_EQ(5u, queue.enqueue_n(in+32, 16));
+    ASSERT_EQ(32u, queue.dequeue_n(out+5, 48));
+    ASSERT_EQ(0u, queue.dequeue_n(out, 1));
+    for (uint32_t i=0; i<37; ++i) ASSERT_EQ(i, out[i]);
+}
+
+TEST_F(QueueTest, DynamicMPMCQueueConcurrentBulk){
+    const uint32_t nProducers = 8;
+    const uint32_t nConsumers = 8;
+    const uint32_t perProducer = 100000;
+    DynamicMPMCQueue<uint64_t> queue(256);
+    atomic<uint64_t> sum{0};
+    atomic<uint32_t> consumed{0};
+    list<thread> threads;
+    for (uint32_t p=0; p<nProducers; ++p){
+        threads.emplace_back([&](){
+            uint64_t batch[16];
+            for (uint32_t i=0; i<perProducer;){
+                uint32_t n = std::min<uint32_t>(16, perProducer-i);
+                for (uint32_t j=0; j<n; ++j) batch[j] = i+j+1;
+                size_t done = queue.enqueue_n(batch, n);
+                if (done == 0){
+                    std::this_thread::yield();
+                    continue;
+                }
+                i+=done;
+            }
+        });
+    }
+    for (uint32_t c=0; c<nConsumers; ++c){
+        threads.emplace_back([&](){
+            uint64_t batch[16];
+            while (consumed.load() < nProducers*perProducer){
+                size_t n = queue.dequeue_n(batch, 16);
+                if (n == 0){
+                    std::this_thread::yield();
+                    continue;
+                }
+                uint64_t local = 0;
+                for (size_t j=0; j<n; ++j) local += batch[j];
+                sum += local;
+                consumed += n;
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+    ASSERT_EQ(nProducers*perProducer, consumed.load());
+    ASSERT_EQ((uint64_t)nProducers*perProducer*(perProducer+1)/2, sum.load());
+}
+
+TEST_F(QueueTest, SPSCQueueOrdering){
+    const uint32_t nItems = 1000000;
+    SPSCQueue<uint32_t, 64> queue;
+    thread producer([&](){
+        for (uint32_t i=0; i<nItems; ++i){
+            queue.enqueue(i);
+            //give the consumer a chance to block on an empty queue
+            if (i % 100000 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    uint32_t x;
+    for (uint32_t i=0; i<nItems; ++i){
+        if (!queue.dequeue(x)) queue.blockingDequeue(x);
+        ASSERT_EQ(i, x);
+    }
+    producer.join();
+    ASSERT_FALSE(queue.dequeue(x));
+}
+
+TEST_F(QueueTest, SPSCQueueOverflow){
+    //enqueues past a full ring don't wait, and come out in order after it
+    SPSCQueue<uint32_t, 4> queue;
+    std::vector<uint32_t> out;
+    auto collect = [&out](uint32_t&& x){out.push_back(x);};
+    uint32_t next = 0;
+    for (uint32_t round=0; round<3; ++round){
+        for (uint32_t i=0; i<20; ++i) queue.enqueue(next++);
+        //the ring has room again, but the list still holds older items
+        ASSERT_EQ(3u, queue.bulkDequeue(collect, 3));
+        ASSERT_FALSE(queue.tryEmplace(next));
+        queue.enqueue(next++);
+        uint32_t x;
+        ASSERT_TRUE(queue.dequeue(x));
+        out.push_back(x);
+        size_t remaining = next - out.size();
+        ASSERT_EQ(remaining, queue.bulkDequeue(collect));
+        ASSERT_FALSE(queue.dequeue(x));
+        //with the list drained, the ring is used again
+        ASSERT_TRUE(queue.tryEmplace(next++));
+        ASSERT_EQ(1u, queue.bulkDequeue(collect));
+    }
+    ASSERT_EQ(next, out.size());
+    for (uint32_t i=0; i<next; ++i) ASSERT_EQ(i, out[i]);
+    
+    //items still in the list on destruction are cleaned up
+    auto item = std::make_shared<uint32_t>(0);
+    {
+        SPSCQueue<std::shared_ptr<uint32_t>, 4> pending;
+        for (uint32_t i=0; i<10; ++i) pending.enqueue(item);
+    }
+    ASSERT_EQ(1, item.use_count());
+}
+
+TEST_F(QueueTest, SPSCQueueWakesSleepingReader){
+    //each item is published after the consumer has spun and gone to sleep
+    const uint32_t nItems = 200;
+    SPSCQueue<uint32_t, 4> queue;
+    thread producer([&](){
+        for (uint32_t i=0; i<nItems; ++i){
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            queue.enqueue(i);
+        }
+        queue.unblock();
+    });
+    uint32_t x;
+    for (uint32_t i=0; i<nItems; ++i){
+        queue.blockingDequeue(x);
+        ASSERT_EQ(i, x);
+    }
+    queue.waitForItems();
+    ASSERT_FALSE(queue.dequeue(x));
+    producer.join();
+}
+
+TEST_F(QueueTest, MPSCQueueBulkDequeue){
+    MPSCQueue<uint32_t, 16> queue;
+    std::vector<uint32_t> out;
+    auto collect = [&out](uint32_t&& x){out.push_back(x);};
+    
+    //fills the cache, then the list
+    for (uint32_t i=0; i<100; ++i) queue.enqueue(i);
+    ASSERT_EQ(10u, queue.bulkDequeue(collect, 10));
+    ASSERT_EQ(50u, queue.bulkDequeue(collect, 50));
+    ASSERT_EQ(40u, queue.bulkDequeue(collect));
+    ASSERT_EQ(0u, queue.bulkDequeue(collect));
+    ASSERT_EQ(100u, out.size());
+    std::sort(out.begin(), out.end());
+    for (uint32_t i=0; i<100; ++i) ASSERT_EQ(i, out[i]);
+    
+    //list nodes still pending on destruction are cleaned up
+    for (uint32_t i=0; i<100; ++i) queue.enqueue(i);
+    ASSERT_EQ(20u, queue.bulkDequeue(collect, 20));
+}
+
+TEST_F(QueueTest, MPSCQueueConcurrentBulkDequeue){
+    const uint32_t nProducers = 8;
+    const uint32_t perProducer = 100000;
+    MPSCQueue<uint64_t> queue;
+    list<thread> producers;
+    for (uint32_t p=0; p<nProducers; ++p){
+        producers.emplace_back([&](){
+            for (uint32_t i=1; i<=perProducer; ++i) queue.enqueue(i);
+        });
+    }
+    uint64_t sum = 0;
+    uint32_t consumed = 0;
+    while (consumed < nProducers*perProducer){
+        uint32_t n = queue.bulkDequeue([&sum](uint64_t&& x){sum += x;}, 64);
+        if (!n) std::this_thread::yield();
+        consumed += n;
+    }
+    for (auto &t : producers) t.join();
+    ASSERT_EQ((uint64_t)nProducers*perProducer*(perProducer+1)/2, sum);
+}
+
+TEST_F(QueueTest, MPSCQueueProducerOrdering){
+    //a small cache, so that producers regularly spill into the list
+    const uint32_t nProducers = 4;
+    const uint32_t perProducer = 200000;
+    MPSCQueue<std::pair<uint32_t, uint32_t>, 4> queue;
+    list<thread> producers;
+    for (uint32_t p=0; p<nProducers; ++p){
+        producers.emplace_back([&queue, p](){
+            for (uint32_t i=1; i<=perProducer; ++i) queue.enqueue(std::make_pair(p, i));
+        });
+    }
+    std::vector<uint32_t> lastSeen(nProducers, 0);
+    uint32_t consumed = 0;
+    bool ordered = true;
+    std::pair<uint32_t, uint32_t> item;
+    while (consumed < nProducers*perProducer){
+        if (!queue.dequeue(item)){
+            std::this_thread::yield();
+            continue;
+        }
+        ordered &= (lastSeen[item.first] + 1 == item.second);
+        lastSeen[item.first] = item.second;
+        ++consumed;
+    }
+    for (auto &t : producers) t.join();
+    ASSERT_TRUE(ordered);
+}
+
+struct ThrowingCopy{
+    ThrowingCopy(uint32_t v) : value(v){}
+    ThrowingCopy(const ThrowingCopy& that) : value(that.value){
+        if (value % 3 == 0) throw std::runtime_error("copy");
+    }
+    ThrowingCopy(ThrowingCopy&&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) = default;
+    uint32_t value;
+};
+
+//items whose copy throws are skipped, rather than wedging the queue
+template <typename Queue>
+void checkThrowingEnqueue(Queue& queue){
+    std::vector<uint32_t> out;
+    for (uint32_t round=0; round<4; ++round){
+        for (uint32_t i=1; i<=20; ++i){
+            ThrowingCopy item(i);
+            if (i % 3 == 0) ASSERT_THROW(queue.enqueue(item), std::runtime_error);
+            else queue.enqueue(item);
+        }
+        ThrowingCopy x(0);
+        while (queue.dequeue(x)) out.push_back(x.value);
+        ASSERT_EQ((round + 1)*14u, out.size());
+    }
+    for (auto v : out) ASSERT_NE(0u, v % 3);
+}
+
+TEST_F(QueueTest, ThrowingConstruction){
+    std::unique_ptr<ContiguousMPMCQueue<ThrowingCopy, 32>> contiguous(new ContiguousMPMCQueue<ThrowingCopy, 32>);
+    checkThrowingEnqueue(*contiguous);
+    DynamicMPMCQueue<ThrowingCopy, MPMCLayout::SCRAMBLED> dynamic(32);
+    checkThrowingEnqueue(dynamic);
+    MPSCQueue<ThrowingCopy, 4> mpsc;
+    checkThrowingEnqueue(mpsc);
+    
+    //a throw part way through a bulk enqueue leaves the rest of the run as holes
+    std::vector<ThrowingCopy> in;
+    for (uint32_t i=1; i<=8; ++i) in.emplace_back(i);
+    ASSERT_THROW(dynamic.enqueue_n(in.data(), in.size()), std::runtime_error);
+    ThrowingCopy out[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    ASSERT_EQ(2u, dynamic.dequeue_n(out, 8));
+    ASSERT_EQ(1u, out[0].value);
+    ASSERT_EQ(2u, out[1].value);
+    ASSERT_EQ(0u, dynamic.dequeue_n(out, 8));
+    ASSERT_TRUE(dynamic.enqueue(ThrowingCopy(4)));
+    ASSERT_EQ(1u, dynamic.dequeue_n(out, 8));
+    ASSERT_EQ(4u, out[0].value);
+}
+
+TEST_F(QueueTest, BulkDequeueReleasesCellsBeforeInvoking){
+    //a full queue has room again by the time each item is invoked
+    ContiguousMPMCQueue<uint32_t, 4> mpmc;
+    for (uint32_t i=0; i<4; ++i) ASSERT_TRUE(mpmc.enqueue(i));
+    uint32_t reenqueued = 0;
+    ASSERT_EQ(4u, mpmc.bulkDequeue([&](uint32_t&& x){
+        if (mpmc.enqueue(x + 4)) ++reenqueued;
+    }, 4));
+    ASSERT_EQ(4u, reenqueued);
+    
+    SPSCQueue<uint32_t, 4> spsc;
+    for (uint32_t i=0; i<4; ++i) spsc.enqueue(i);
+    reenqueued = 0;
+    ASSERT_EQ(4u, spsc.bulkDequeue([&](uint32_t&& x){
+        if (spsc.tryEmplace(x + 4)) ++reenqueued;
+    }, 4));
+    ASSERT_EQ(4u, reenqueued);
+}
+
+TEST_F(QueueTest, BulkDequeueThrowingCallback){
+    //the rest of a claimed run is dropped, and the queue stays usable
+    std::unique_ptr<ContiguousMPMCQueue<std::shared_ptr<uint32_t>, 8>> mpmc(new ContiguousMPMCQueue<std::shared_ptr<uint32_t>, 8>);
+    auto item = std::make_shared<uint32_t>(0);
+    auto throwOnThird = [](std::shared_ptr<uint32_t>&& x){
+        if (++*x == 3) throw std::runtime_error("callback");
+    };
+    for (uint32_t round=0; round<4; ++round){
+        *item = 0;
+        for (uint32_t i=0; i<8; ++i) ASSERT_TRUE(mpmc->enqueue(item));
+        ASSERT_THROW(mpmc->bulkDequeue(throwOnThird, 8), std::runtime_error);
+        ASSERT_EQ(1, item.use_count());
+    }
+    
+    MPSCQueue<std::shared_ptr<uint32_t>, 4> mpsc;
+    //drain the cache, then throw part way through the list run
+    for (uint32_t i=0; i<12; ++i) mpsc.enqueue(item);
+    ASSERT_EQ(4u, mpsc.bulkDequeue([](std::shared_ptr<uint32_t>&&){}, 4));
+    *item = 0;
+    ASSERT_THROW(mpsc.bulkDequeue(throwOnThird), std::runtime_error);
+    ASSERT_EQ(1, item.use_count());
+    mpsc.enqueue(item);
+    std::shared_ptr<uint32_t> out;
+    ASSERT_TRUE(mpsc.dequeue(out));
+    ASSERT_FALSE(mpsc.dequeue(out));
+}
@@ -0,0 +1,20 @@
+/* 
+ * File:   QueueTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 9:40 AM
+ */
+
+#ifndef BSIGNALS_QUEUETEST_H
+#define BSIGNALS_QUEUETEST_H
+
+#include <gtest/gtest.h>
+
+class QueueTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_QUEUETEST_H */
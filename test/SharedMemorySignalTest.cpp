@@ -0,0 +1,170 @@
+#include "SharedMemorySignalTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef LINUX
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include "BSignals/SharedMemorySignal.hpp"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::SharedMemoryEmitter;
+using BSignals::SharedMemoryReceiver;
+using BSignals::ExecutorScheme;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+using std::string;
+
+#ifdef LINUX
+namespace{
+//unique per process, so concurrent test runs don't share rings
+string ringName(const string& test){
+    return "/BSignalsTest." + test + "." + std::to_string(getpid());
+}
+
+struct Tick{
+    uint32_t instrument;
+    double price;
+};
+}
+#endif
+
+void SharedMemorySignalTest::SetUp() {
+
+}
+
+void SharedMemorySignalTest::TearDown() {
+
+}
+
+#ifdef LINUX
+TEST_F(SharedMemorySignalTest, SameProcess){
+    SharedMemoryReceiver<uint32_t, Tick> receiver(ringName("SameProcess"), 64);
+    vector<uint32_t> received;
+    atomic<uint32_t> count{0};
+    receiver.connectSlot(ExecutorScheme::SYNCHRONOUS, [&](uint32_t sequence, Tick tick){
+        ASSERT_EQ(sequence, tick.instrument);
+        received.push_back(sequence);
+        ++count;
+    });
+    SharedMemoryEmitter<uint32_t, Tick> emitter(ringName("SameProcess"));
+    //many times the capacity of the ring, so producers wait for space
+    const uint32_t nEmissions = 100000;
+    for (uint32_t i=0; i<nEmissions; ++i){
+        emitter.emitSignal(i, Tick{i, i*0.5});
+    }
+    BasicTimer bt;
+    bt.start();
+    while (count != nEmissions && bt.getElapsedSeconds() < 10.0) std::this_thread::yield();
+    ASSERT_EQ(nEmissions, count);
+    for (uint32_t i=0; i<nEmissions; ++i){
+        ASSERT_EQ(i, received[i]);
+    }
+}
+
+TEST_F(SharedMemorySignalTest, DeferredSlots){
+    SharedMemoryReceiver<uint32_t> receiver(ringName("DeferredSlots"));
+    uint64_t sum = 0;
+    receiver.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [&sum](uint32_t x){
+        sum += x;
+    });
+    SharedMemoryEmitter<uint32_t> emitter(ringName("DeferredSlots"));
+    for (uint32_t i=1; i<=100; ++i){
+        emitter.emitSignal(i);
+    }
+    BasicTimer bt;
+    bt.start();
+    while (sum != 5050 && bt.getElapsedSeconds() < 10.0){
+        receiver.invokeDeferred();
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(5050u, sum);
+}
+
+TEST_F(SharedMemorySignalTest, AcrossProcesses){
+    const string name = ringName("AcrossProcesses");
+    const uint32_t nProducers = 2;
+    const uint32_t nEmissions = 50000;
+    SharedMemoryReceiver<uint32_t, uint32_t> receiver(name, 1024);
+    vector<vector<uint32_t>> received(nProducers);
+    atomic<uint32_t> count{0};
+    receiver.connectSlot(ExecutorScheme::STRAND, [&](uint32_t producer, uint32_t sequence){
+        received[producer].push_back(sequence);
+        ++count;
+    });
+    vector<pid_t> children;
+    for (uint32_t p=0; p<nProducers; ++p){
+        pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0){
+            SharedMemoryEmitter<uint32_t, uint32_t> emitter(name);
+            for (uint32_t i=0; i<nEmissions; ++i){
+                emitter.emitSignal(p, i);
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (auto pid : children){
+        int status;
+        waitpid(pid, &status, 0);
+        ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    BasicTimer bt;
+    bt.start();
+    while (count != nProducers*nEmissions && bt.getElapsedSeconds() < 10.0) std::this_thread::yield();
+    ASSERT_EQ(nProducers*nEmissions, count);
+    //each producer's emissions arrive in the order they were made
+    for (auto &r : received){
+        ASSERT_EQ(nEmissions, r.size());
+        for (uint32_t i=0; i<nEmissions; ++i){
+            ASSERT_EQ(i, r[i]);
+        }
+    }
+}
+
+TEST_F(SharedMemorySignalTest, OpenErrors){
+    ASSERT_THROW(SharedMemoryEmitter<uint32_t>(ringName("Missing")), std::system_error);
+    SharedMemoryReceiver<uint32_t> receiver(ringName("OpenErrors"));
+    SharedMemoryEmitter<uint32_t> emitter(ringName("OpenErrors"));
+    ASSERT_THROW(SharedMemoryEmitter<Tick>(ringName("OpenErrors")), std::invalid_argument);
+    //arguments of the same size, but different types
+    ASSERT_THROW(SharedMemoryEmitter<float>(ringName("OpenErrors")), std::invalid_argument);
+    ASSERT_THROW(SharedMemoryEmitter<int32_t>(ringName("OpenErrors")), std::invalid_argument);
+    ASSERT_THROW((SharedMemoryEmitter<uint16_t, uint16_t>(ringName("OpenErrors"))), std::invalid_argument);
+    ASSERT_THROW(SharedMemoryReceiver<uint32_t>(ringName("Capacity"), 1000), std::invalid_argument);
+}
+
+TEST_F(SharedMemorySignalTest, Latency){
+    SharedMemoryReceiver<uint64_t> receiver(ringName("Latency"));
+    atomic<uint64_t> last{0};
+    receiver.connectSlot(ExecutorScheme::SYNCHRONOUS, [&last](uint64_t x){
+        last.store(x);
+    });
+    SharedMemoryEmitter<uint64_t> emitter(ringName("Latency"));
+    const uint32_t nEmissions = 10000;
+    BasicTimer bt;
+    bt.start();
+    for (uint64_t i=1; i<=nEmissions; ++i){
+        emitter.emitSignal(i);
+        while (last.load() != i) std::this_thread::yield();
+    }
+    bt.stop();
+    cout << "Average round trip through the ring: " << bt.getElapsedNanoseconds()/nEmissions << "ns" << endl;
+}
+#else
+TEST_F(SharedMemorySignalTest, Unsupported){
+    //shared memory signals are only implemented for linux
+    ASSERT_THROW((SharedMemoryReceiver<uint32_t>("/BSignalsTest", 16)), std::system_error);
+}
+#endif
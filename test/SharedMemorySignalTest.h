@@ -0,0 +1,20 @@
+/* 
+ * File:   SharedMemorySignalTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 2:55 AM
+ */
+
+#ifndef BSIGNALS_SHAREDMEMORYSIGNALTEST_H
+#define BSIGNALS_SHAREDMEMORYSIGNALTEST_H
+
+#include <gtest/gtest.h>
+
+class SharedMemorySignalTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_SHAREDMEMORYSIGNALTEST_H */
@@ -0,0 +1,170 @@
+#include "SignalBusTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/SignalBus.hpp"
+#include "BSignals/details/BasicTimer.h"
+
+using BSignals::Signal;
+using BSignals::SignalBus;
+using BSignals::ExecutorScheme;
+using BSignals::details::BasicTimer;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+using std::string;
+
+void SignalBusTest::SetUp() {
+
+}
+
+void SignalBusTest::TearDown() {
+
+}
+
+TEST_F(SignalBusTest, ExactTopics){
+    SignalBus<int> bus;
+    auto a = bus.getTopic("a");
+    auto b = bus.getTopic("b");
+    ASSERT_TRUE(a.isValid());
+    int sumA = 0, sumB = 0;
+    bus.subscribe("a", ExecutorScheme::SYNCHRONOUS, [&sumA](int x){sumA += x;});
+    bus.subscribe("b", ExecutorScheme::SYNCHRONOUS, [&sumB](int x){sumB += x;});
+    bus.publish(a, 1);
+    bus.publish(b, 10);
+    //interning the same name again returns the same topic
+    bus.publish(bus.getTopic("a"), 2);
+    ASSERT_EQ(sumA, 3);
+    ASSERT_EQ(sumB, 10);
+}
+
+TEST_F(SignalBusTest, Wildcards){
+    SignalBus<string> bus;
+    vector<string> single, multi, exact;
+    //subscriptions made before and after their topics exist
+    bus.subscribe("market/*/quote", ExecutorScheme::SYNCHRONOUS, [&single](string s){single.push_back(s);});
+    auto aaplQuote = bus.getTopic("market/AAPL/quote");
+    auto aaplTrade = bus.getTopic("market/AAPL/trade");
+    int multiId = bus.subscribe("market/#", ExecutorScheme::SYNCHRONOUS, [&multi](string s){multi.push_back(s);});
+    auto msftQuote = bus.getTopic("market/MSFT/quote");
+    auto deep = bus.getTopic("market/MSFT/quote/level2");
+    auto other = bus.getTopic("news/MSFT");
+    bus.subscribe("market/MSFT/quote", ExecutorScheme::SYNCHRONOUS, [&exact](string s){exact.push_back(s);});
+    
+    for (auto topic : {aaplQuote, aaplTrade, msftQuote, deep, other}){
+        bus.publish(topic, "x");
+    }
+    ASSERT_EQ(single.size(), 2u);
+    ASSERT_EQ(multi.size(), 4u);
+    ASSERT_EQ(exact.size(), 1u);
+    ASSERT_EQ(bus.getMatchCount(multiId), 4u);
+    
+    bus.unsubscribe(multiId);
+    ASSERT_EQ(bus.getMatchCount(multiId), 0u);
+    bus.publish(aaplTrade, "x");
+    ASSERT_EQ(multi.size(), 4u);
+}
+
+TEST_F(SignalBusTest, WildcardStrandSubscription){
+    SignalBus<uint32_t> bus;
+    const uint32_t nTopics = 8;
+    const uint32_t nEmissions = 10000;
+    vector<SignalBus<uint32_t>::Topic> topics;
+    for (uint32_t i=0; i<nTopics/2; ++i) topics.push_back(bus.getTopic("t/" + std::to_string(i)));
+    atomic<uint32_t> received{0};
+    bool ordered = true;
+    std::thread::id executor;
+    bool oneThread = true;
+    int id = bus.subscribe("t/#", ExecutorScheme::STRAND, [&](uint32_t x){
+        //one strand thread for every topic, executing in order of publishing
+        if (x == 0) executor = std::this_thread::get_id();
+        else if (executor != std::this_thread::get_id()) oneThread = false;
+        if (x != received) ordered = false;
+        ++received;
+    });
+    for (uint32_t i=nTopics/2; i<nTopics; ++i) topics.push_back(bus.getTopic("t/" + std::to_string(i)));
+    ASSERT_EQ(bus.getMatchCount(id), nTopics);
+    for (uint32_t i=0; i<nEmissions; ++i) bus.publish(topics[i % nTopics], i);
+    while (received < nEmissions) std::this_thread::yield();
+    ASSERT_TRUE(ordered);
+    ASSERT_TRUE(oneThread);
+    bus.unsubscribe(id);
+}
+
+TEST_F(SignalBusTest, InvalidPatterns){
+    SignalBus<int> bus;
+    ASSERT_THROW(bus.subscribe("a/#/b", ExecutorScheme::SYNCHRONOUS, [](int){}), std::invalid_argument);
+    ASSERT_THROW(bus.subscribe("#/b", ExecutorScheme::SYNCHRONOUS, [](int){}), std::invalid_argument);
+    ASSERT_THROW(bus.subscribe("a/*", ExecutorScheme::SINGLE_PRODUCER_STRAND, [](int){}), std::invalid_argument);
+    ASSERT_THROW(bus.subscribe("a/b", ExecutorScheme::DEFERRED_SYNCHRONOUS, [](int){}), std::invalid_argument);
+    ASSERT_THROW(bus.subscribe("a/*", ExecutorScheme::DEFERRED_BUFFERED, [](int){}), std::invalid_argument);
+    //without wildcards only one topic can match
+    int id = bus.subscribe("a/b", ExecutorScheme::SINGLE_PRODUCER_STRAND, [](int){});
+    bus.getTopic("a/b");
+    ASSERT_EQ(bus.getMatchCount(id), 1u);
+}
+
+TEST_F(SignalBusTest, ConcurrentSubscription){
+    SignalBus<int> bus(true);
+    auto topic = bus.getTopic("a/b");
+    atomic<bool> stop{false};
+    atomic<uint32_t> received{0};
+    std::thread publisher([&](){
+        while (!stop) bus.publish(topic, 1);
+    });
+    for (uint32_t i=0; i<100; ++i){
+        int id = bus.subscribe("a/*", ExecutorScheme::SYNCHRONOUS, [&received](int){++received;});
+        bus.subscribe("a/#", ExecutorScheme::SYNCHRONOUS, [](int){});
+        bus.unsubscribe(id);
+    }
+    stop = true;
+    publisher.join();
+    ASSERT_EQ(bus.getMatchCount(199), 1u);
+}
+
+TEST_F(SignalBusTest, HandleVersusNameLookup){
+    const uint32_t nTopics = 1000;
+    const uint32_t nPublishes = 1000000;
+    vector<string> names;
+    for (uint32_t i=0; i<nTopics; ++i){
+        names.push_back("instruments/equities/" + std::to_string(i) + "/quote");
+    }
+    uint64_t sum = 0;
+    
+    //the registry approach: look the signal up by name on every publish
+    std::unordered_map<string, std::unique_ptr<Signal<uint32_t>>> registry;
+    for (auto &name : names){
+        registry.emplace(name, std::unique_ptr<Signal<uint32_t>>(new Signal<uint32_t>));
+        registry[name]->connectSlot(ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){sum += x;});
+    }
+    SignalBus<uint32_t> bus;
+    vector<SignalBus<uint32_t>::Topic> topics;
+    bus.subscribe("instruments/equities/*/quote", ExecutorScheme::SYNCHRONOUS, [&sum](uint32_t x){sum += x;});
+    for (auto &name : names){
+        topics.push_back(bus.getTopic(name));
+    }
+    
+    BasicTimer timer;
+    timer.start();
+    for (uint32_t i=0; i<nPublishes; ++i){
+        registry[names[i % nTopics]]->emitSignal(1);
+    }
+    timer.stop();
+    double lookupTime = timer.getElapsedNanoseconds();
+    timer.start();
+    for (uint32_t i=0; i<nPublishes; ++i){
+        bus.publish(topics[i % nTopics], 1);
+    }
+    timer.stop();
+    double handleTime = timer.getElapsedNanoseconds();
+    cout << "Name lookup: " << lookupTime/nPublishes << "ns per publish" << endl;
+    cout << "Topic handle: " << handleTime/nPublishes << "ns per publish" << endl;
+    ASSERT_EQ(sum, 2u*nPublishes);
+}
@@ -0,0 +1,20 @@
+/* 
+ * File:   SignalBusTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 11:50 PM
+ */
+
+#ifndef BSIGNALS_SIGNALBUSTEST_H
+#define BSIGNALS_SIGNALBUSTEST_H
+
+#include <gtest/gtest.h>
+
+class SignalBusTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_SIGNALBUSTEST_H */
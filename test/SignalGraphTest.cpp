@@ -0,0 +1,189 @@
+#include "SignalGraphTest.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <stdexcept>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/SignalGraph.h"
+
+using BSignals::Signal;
+using BSignals::SignalGraph;
+using BSignals::ExecutorScheme;
+using std::cout;
+using std::endl;
+using std::atomic;
+using std::vector;
+
+void SignalGraphTest::SetUp() {
+
+}
+
+void SignalGraphTest::TearDown() {
+
+}
+
+TEST_F(SignalGraphTest, DependencyOrder){
+    //a -> {b, d, e}, b -> c, {c, d, e} -> f, f -> g
+    SignalGraph graph;
+    atomic<uint32_t> sequence{0};
+    vector<uint32_t> order(7, 0);
+    vector<uint32_t> ids;
+    for (uint32_t i=0; i<7; ++i){
+        ids.push_back(graph.addNode(std::string(1, 'a' + i), [&order, &sequence, i](){
+            order[i] = ++sequence;
+        }));
+    }
+    vector<std::pair<uint32_t, uint32_t>> edges{{0,1}, {1,2}, {2,5}, {0,3}, {3,5}, {0,4}, {4,5}, {5,6}};
+    for (auto &e : edges){
+        graph.addEdge(ids[e.first], ids[e.second]);
+    }
+    for (uint32_t run=1; run<=100; ++run){
+        graph.run();
+        for (auto &e : edges){
+            ASSERT_LT(order[e.first], order[e.second]);
+        }
+        ASSERT_EQ(graph.getNodeTiming(ids[6]).runs, run);
+    }
+    //{a}, {b-c, d, e}, {f-g}
+    ASSERT_EQ(graph.getWaveCount(), 3u);
+}
+
+TEST_F(SignalGraphTest, ChainsRunInline){
+    SignalGraph graph;
+    vector<std::thread::id> threads(4);
+    uint32_t previous = UINT32_MAX;
+    //a fan out, so that chains are handed to the pool
+    uint32_t root = graph.addNode("root", [](){});
+    for (uint32_t chain=0; chain<2; ++chain){
+        previous = root;
+        for (uint32_t i=0; i<2; ++i){
+            uint32_t index = chain*2 + i;
+            uint32_t id = graph.addNode("link", [&threads, index](){
+                threads[index] = std::this_thread::get_id();
+            });
+            graph.addEdge(previous, id);
+            previous = id;
+        }
+    }
+    graph.run();
+    ASSERT_EQ(graph.getWaveCount(), 2u);
+    ASSERT_EQ(threads[0], threads[1]);
+    ASSERT_EQ(threads[2], threads[3]);
+}
+
+TEST_F(SignalGraphTest, WaveRunsConcurrently){
+    SignalGraph graph;
+    atomic<uint32_t> arrived{0};
+    atomic<bool> timedOut{false};
+    //each node waits for the other, which only completes if they run concurrently
+    auto rendezvous = [&](){
+        ++arrived;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (arrived < 2){
+            if (std::chrono::steady_clock::now() > deadline){
+                timedOut = true;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+    graph.addNode("left", rendezvous);
+    graph.addNode("right", rendezvous);
+    graph.run();
+    ASSERT_FALSE(timedOut);
+}
+
+TEST_F(SignalGraphTest, CriticalPath){
+    SignalGraph graph;
+    auto sleeper = [](uint32_t ms){
+        return [ms](){std::this_thread::sleep_for(std::chrono::milliseconds(ms));};
+    };
+    uint32_t a = graph.addNode("a", sleeper(1));
+    uint32_t slow = graph.addNode("slow", sleeper(30));
+    uint32_t fast = graph.addNode("fast", sleeper(1));
+    uint32_t d = graph.addNode("d", sleeper(1));
+    graph.addEdge(a, slow);
+    graph.addEdge(a, fast);
+    graph.addEdge(slow, d);
+    graph.addEdge(fast, d);
+    graph.run();
+    std::chrono::nanoseconds length;
+    auto path = graph.getCriticalPath(&length);
+    ASSERT_EQ(path, (vector<uint32_t>{a, slow, d}));
+    ASSERT_GE(length, std::chrono::milliseconds(32));
+    for (auto n : path){
+        cout << graph.getNodeTiming(n).name << ": " << graph.getNodeTiming(n).last.count() << "ns" << endl;
+    }
+}
+
+TEST_F(SignalGraphTest, SignalNodes){
+    //each node emits a signal, whose synchronous slot produces the input of the next
+    Signal<int> parsed, scaled;
+    int input = 0, parsedValue = 0, scaledValue = 0;
+    parsed.connectSlot(ExecutorScheme::SYNCHRONOUS, [&parsedValue](int x){parsedValue = x;});
+    scaled.connectSlot(ExecutorScheme::SYNCHRONOUS, [&scaledValue](int x){scaledValue = x;});
+    SignalGraph graph;
+    uint32_t parse = graph.addNode("parse", [&](){parsed.emitSignal(input + 1);});
+    uint32_t scale = graph.addNode("scale", [&](){scaled.emitSignal(parsedValue * 2);});
+    graph.addEdge(parse, scale);
+    for (input = 0; input < 10; ++input){
+        graph.run();
+        ASSERT_EQ(scaledValue, (input + 1) * 2);
+    }
+}
+
+TEST_F(SignalGraphTest, InvalidGraphs){
+    SignalGraph graph;
+    uint32_t a = graph.addNode("a", [](){});
+    uint32_t b = graph.addNode("b", [](){});
+    ASSERT_THROW(graph.addEdge(a, 5), std::out_of_range);
+    graph.addEdge(a, b);
+    graph.addEdge(b, a);
+    ASSERT_THROW(graph.run(), std::invalid_argument);
+}
+
+TEST_F(SignalGraphTest, RunAsyncFromPoolThread){
+    //a -> {b, c} -> d, run from a pool worker
+    SignalGraph graph;
+    atomic<uint32_t> sequence{0};
+    vector<uint32_t> order(4, 0);
+    vector<uint32_t> ids;
+    for (uint32_t i=0; i<4; ++i){
+        ids.push_back(graph.addNode(std::string(1, 'a' + i), [&order, &sequence, i](){
+            order[i] = ++sequence;
+        }));
+    }
+    graph.addEdge(ids[0], ids[1]);
+    graph.addEdge(ids[0], ids[2]);
+    graph.addEdge(ids[1], ids[3]);
+    graph.addEdge(ids[2], ids[3]);
+
+    Signal<uint32_t> signal;
+    atomic<uint32_t> completed{0};
+    atomic<bool> threw{false};
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [&](uint32_t){
+        try{
+            graph.run();
+        }
+        catch (std::logic_error&){
+            threw = true;
+        }
+        graph.runAsync().then([&completed](){++completed;});
+    });
+    signal.emitSignal(0);
+    while (completed == 0) std::this_thread::yield();
+    ASSERT_TRUE(threw);
+    ASSERT_LT(order[0], order[1]);
+    ASSERT_LT(order[0], order[2]);
+    ASSERT_LT(order[1], order[3]);
+    ASSERT_LT(order[2], order[3]);
+
+    for (uint32_t run=2; run<=100; ++run){
+        graph.runAsync().wait();
+        ASSERT_EQ(graph.getNodeTiming(ids[3]).runs, run);
+    }
+}
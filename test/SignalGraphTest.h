@@ -0,0 +1,20 @@
+/* 
+ * File:   SignalGraphTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 11:05 PM
+ */
+
+#ifndef BSIGNALS_SIGNALGRAPHTEST_H
+#define BSIGNALS_SIGNALGRAPHTEST_H
+
+#include <gtest/gtest.h>
+
+class SignalGraphTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_SIGNALGRAPHTEST_H */
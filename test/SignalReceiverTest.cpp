@@ -0,0 +1,279 @@
+#include "SignalReceiverTest.h"
+#include <iostream>
+#include <list>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/EventLoop.h"
+#include "BSignals/SignalReceiver.hpp"
+
+using BSignals::Signal;
+using BSignals::BasicSignal;
+using BSignals::CountingInstrumentation;
+using BSignals::SignalReceiver;
+using BSignals::EventLoop;
+using std::cout;
+using std::endl;
+using std::list;
+using std::thread;
+using std::atomic;
+using std::vector;
+
+void SignalReceiverTest::SetUp() {
+
+}
+
+void SignalReceiverTest::TearDown() {
+
+}
+
+namespace{
+//a consumer written as a callback state machine, standing in for a coroutine
+struct Consumer{
+    typedef SignalReceiver<uint32_t, uint32_t> Receiver;
+    
+    Consumer(Signal<uint32_t, uint32_t>& signal, EventLoop& loop)
+    : receiver(signal, loop){
+        waiter.resume = [](void* context){
+            Consumer* self = static_cast<Consumer*>(context);
+            self->receiver.receiveAfterWait(self->value);
+            self->consume();
+            self->run();
+        };
+        waiter.context = this;
+    }
+    
+    void run(){
+        while (receiver.receiveOrWait(value, waiter)){
+            consume();
+        }
+    }
+    
+    void consume(){
+        ordered &= (std::get<1>(value) == lastSeen[std::get<0>(value)] + 1);
+        lastSeen[std::get<0>(value)] = std::get<1>(value);
+        ++received;
+    }
+    
+    Receiver receiver;
+    Receiver::Waiter waiter;
+    Receiver::ArgsTuple value;
+    uint32_t lastSeen[4]{0, 0, 0, 0};
+    uint32_t received{0};
+    bool ordered{true};
+};
+}
+
+TEST_F(SignalReceiverTest, Poll){
+    Signal<int, std::string> signal;
+    SignalReceiver<int, std::string> receiver(signal);
+    SignalReceiver<int, std::string>::ArgsTuple value;
+    ASSERT_FALSE(receiver.tryReceive(value));
+    for (int i=0; i<1000; ++i) signal.emitSignal(i, std::to_string(i));
+    for (int i=0; i<1000; ++i){
+        ASSERT_TRUE(receiver.tryReceive(value));
+        ASSERT_EQ(i, std::get<0>(value));
+        ASSERT_EQ(std::to_string(i), std::get<1>(value));
+    }
+    ASSERT_FALSE(receiver.tryReceive(value));
+}
+
+TEST_F(SignalReceiverTest, InstrumentedSignal){
+    BasicSignal<CountingInstrumentation, int> signal;
+    EventLoop loop;
+    SignalReceiver<int> receiver(signal);
+    SignalReceiver<int> onLoop(signal, loop);
+    SignalReceiver<int>::ArgsTuple value;
+    for (int i=0; i<10; ++i) signal.emitSignal(i);
+    for (int i=0; i<10; ++i){
+        ASSERT_TRUE(receiver.tryReceive(value));
+        ASSERT_EQ(i, std::get<0>(value));
+        ASSERT_TRUE(onLoop.tryReceive(value));
+    }
+    ASSERT_EQ(10u, signal.getInstrumentation().getEmissionCount());
+}
+
+TEST_F(SignalReceiverTest, WaiterResumedOnExecutor){
+    EventLoop loop;
+    Signal<int> signal;
+    SignalReceiver<int> receiver(signal, loop);
+    SignalReceiver<int>::ArgsTuple value;
+    bool resumed = false;
+    SignalReceiver<int>::Waiter waiter{[](void* context){
+        *static_cast<bool*>(context) = true;
+    }, &resumed};
+    
+    ASSERT_FALSE(receiver.receiveOrWait(value, waiter));
+    signal.emitSignal(5);
+    signal.emitSignal(6);
+    //the resumption is posted to the loop rather than run by the emitter
+    ASSERT_FALSE(resumed);
+    ASSERT_EQ(1u, loop.runPending());
+    ASSERT_TRUE(resumed);
+    receiver.receiveAfterWait(value);
+    ASSERT_EQ(5, std::get<0>(value));
+    
+    //already buffered, so no wait is registered
+    resumed = false;
+    ASSERT_TRUE(receiver.receiveOrWait(value, waiter));
+    ASSERT_EQ(6, std::get<0>(value));
+    ASSERT_EQ(0u, loop.runPending());
+    ASSERT_FALSE(resumed);
+}
+
+TEST_F(SignalReceiverTest, ManyConsumers){
+    const uint32_t nConsumers = 1000;
+    const uint32_t nEmitters = 4;
+    const uint32_t nEmissions = 1000;
+    EventLoop loop;
+    Signal<uint32_t, uint32_t> signal(true);
+    vector<std::unique_ptr<Consumer>> consumers;
+    for (uint32_t i=0; i<nConsumers; ++i){
+        consumers.emplace_back(new Consumer(signal, loop));
+        consumers.back()->run();
+    }
+    list<thread> emitters;
+    for (uint32_t i=0; i<nEmitters; ++i){
+        emitters.emplace_back([&signal, i](){
+            for (uint32_t j=1; j<=nEmissions; ++j) signal.emitSignal(i, j);
+        });
+    }
+    auto allReceived = [&](){
+        for (auto &c : consumers) if (c->received != nEmitters*nEmissions) return false;
+        return true;
+    };
+    //every consumer is driven by the one thread running the loop
+    while (!allReceived()){
+        if (!loop.runPending()) std::this_thread::yield();
+    }
+    for (auto &t : emitters) t.join();
+    for (auto &c : consumers) ASSERT_TRUE(c->ordered);
+    consumers.clear();
+    loop.runPending();
+}
+
+TEST_F(SignalReceiverTest, InlineResumptionStress){
+    //the consumer is resumed inline by whichever emitter finds its waiter,
+    //and polls with tryReceive between waits
+    const uint32_t nEmitters = 4;
+    const uint32_t nEmissions = 100000;
+    typedef SignalReceiver<uint32_t> Receiver;
+    struct InlineConsumer{
+        InlineConsumer(Signal<uint32_t>& signal) : receiver(signal){
+            waiter.resume = [](void* context){
+                InlineConsumer* self = static_cast<InlineConsumer*>(context);
+                self->receiver.receiveAfterWait(self->value);
+                self->run();
+            };
+            waiter.context = this;
+        }
+        void run(){
+            do{
+                received.fetch_add(1, std::memory_order_release);
+                while (receiver.tryReceive(value)) received.fetch_add(1, std::memory_order_release);
+            } while (receiver.receiveOrWait(value, waiter));
+        }
+        Receiver receiver;
+        Receiver::Waiter waiter;
+        Receiver::ArgsTuple value;
+        atomic<uint32_t> received{0};
+    };
+    Signal<uint32_t> signal(true);
+    InlineConsumer consumer(signal);
+    //nothing is buffered yet, so this registers the waiter
+    ASSERT_FALSE(consumer.receiver.receiveOrWait(consumer.value, consumer.waiter));
+    list<thread> emitters;
+    for (uint32_t i=0; i<nEmitters; ++i){
+        emitters.emplace_back([&signal](){
+            for (uint32_t j=0; j<nEmissions; ++j) signal.emitSignal(j);
+        });
+    }
+    for (auto &t : emitters) t.join();
+    ASSERT_EQ(nEmitters*nEmissions, consumer.received.load(std::memory_order_acquire));
+    Receiver::ArgsTuple value;
+    ASSERT_FALSE(consumer.receiver.tryReceive(value));
+}
+
+//the coroutine tests are only built by the C++20 build (make coroutines), the
+//waiter handoff they rely on is also covered by the tests above
+#if defined(__cpp_impl_coroutine)
+namespace{
+struct DetachedTask{
+    struct promise_type{
+        DetachedTask get_return_object(){return {};}
+        std::suspend_never initial_suspend() noexcept{return {};}
+        std::suspend_never final_suspend() noexcept{return {};}
+        void return_void(){}
+        void unhandled_exception(){std::terminate();}
+    };
+};
+
+DetachedTask consume(SignalReceiver<int>& receiver, int& sum, int count){
+    for (int i=0; i<count; ++i){
+        auto value = co_await receiver.next();
+        sum += std::get<0>(value);
+    }
+}
+
+DetachedTask pollOrAwait(SignalReceiver<int>& receiver, atomic<int>& received, int count){
+    SignalReceiver<int>::ArgsTuple value;
+    for (int i=0; i<count; ++i){
+        if (i%2 == 0 || !receiver.tryReceive(value)) value = co_await receiver.next();
+        received.fetch_add(std::get<0>(value), std::memory_order_release);
+    }
+}
+}
+
+TEST_F(SignalReceiverTest, Coroutine){
+    EventLoop loop;
+    Signal<int> signal;
+    SignalReceiver<int> receiver(signal, loop);
+    int sum = 0;
+    consume(receiver, sum, 3);
+    signal.emitSignal(1);
+    loop.runPending();
+    ASSERT_EQ(1, sum);
+    signal.emitSignal(2);
+    signal.emitSignal(3);
+    loop.runPending();
+    ASSERT_EQ(6, sum);
+}
+
+TEST_F(SignalReceiverTest, CoroutineResumedFromAnotherThread){
+    //the coroutine is resumed inline on the emitting thread, racing the
+    //suspension on this one
+    const int nEmissions = 100000;
+    Signal<int> signal;
+    SignalReceiver<int> receiver(signal);
+    int sum = 0;
+    consume(receiver, sum, nEmissions);
+    std::thread emitter([&signal](){
+        for (int i=1; i<=nEmissions; ++i) signal.emitSignal(1);
+    });
+    emitter.join();
+    ASSERT_EQ(nEmissions, sum);
+}
+TEST_F(SignalReceiverTest, CoroutineStress){
+    //several emitters race a coroutine which mixes tryReceive with next(),
+    //and is resumed inline by whichever emitter finds it waiting
+    const int nEmitters = 4;
+    const int nEmissions = 100000;
+    Signal<int> signal(true);
+    SignalReceiver<int> receiver(signal);
+    atomic<int> received{0};
+    pollOrAwait(receiver, received, nEmitters*nEmissions);
+    list<thread> emitters;
+    for (int i=0; i<nEmitters; ++i){
+        emitters.emplace_back([&signal](){
+            for (int j=0; j<nEmissions; ++j) signal.emitSignal(1);
+        });
+    }
+    for (auto &t : emitters) t.join();
+    ASSERT_EQ(nEmitters*nEmissions, received.load(std::memory_order_acquire));
+    SignalReceiver<int>::ArgsTuple value;
+    ASSERT_FALSE(receiver.tryReceive(value));
+}
+#endif
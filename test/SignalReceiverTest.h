@@ -0,0 +1,20 @@
+/* 
+ * File:   SignalReceiverTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 19 October 2026, 7:50 PM
+ */
+
+#ifndef BSIGNALS_SIGNALRECEIVERTEST_H
+#define BSIGNALS_SIGNALRECEIVERTEST_H
+
+#include <gtest/gtest.h>
+
+class SignalReceiverTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_SIGNALRECEIVERTEST_H */
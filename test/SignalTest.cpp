@@ -4,6 +4,11 @@
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <set>
+#include <mutex>
+#include <string>
+#include <stdexcept>
 
 #include "BSignals/details/BasicTimer.h"
 #include "SafeQueue.hpp"
@@ -109,6 +114,383 @@ TEST_F(SignalTest, DeferredSynchronousSignal) {
     testSignal.disconnectSlot(0);
 }
 
+TEST_F(SignalTest, DeferredSynchronousBudget) {
+    for (auto threadSafe : {false, true}){
+        Signal<int> testSignal(threadSafe);
+        int invoked = 0;
+        testSignal.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [&invoked](int x){
+            invoked += x;
+        });
+        for (uint32_t i=0; i<1000; ++i) testSignal.emitSignal(1);
+        
+        ASSERT_EQ(900u, testSignal.invokeDeferred(100));
+        ASSERT_EQ(100, invoked);
+        ASSERT_EQ(800u, testSignal.invokeDeferred(100));
+        ASSERT_EQ(200, invoked);
+        
+        //a zero budget expires before anything is invoked
+        ASSERT_EQ(800u, testSignal.invokeDeferred(std::chrono::nanoseconds(0)));
+        ASSERT_EQ(200, invoked);
+        ASSERT_EQ(0u, testSignal.invokeDeferred(std::chrono::seconds(10)));
+        ASSERT_EQ(1000, invoked);
+        ASSERT_EQ(0u, testSignal.invokeDeferred(100));
+    }
+    
+    //slow slots are cut off by the time budget, leaving the rest pending
+    Signal<int> testSignal;
+    uint32_t slowInvoked = 0;
+    testSignal.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [&slowInvoked](int){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++slowInvoked;
+    });
+    for (uint32_t i=0; i<100; ++i) testSignal.emitSignal(1);
+    uint32_t remaining = testSignal.invokeDeferred(std::chrono::milliseconds(16));
+    ASSERT_GT(remaining, 0u);
+    ASSERT_LT(remaining, 100u);
+    ASSERT_EQ(100u, slowInvoked + remaining);
+    
+    //the remaining count is exactly what is still pending
+    ASSERT_EQ(0u, testSignal.invokeDeferred(remaining));
+    ASSERT_EQ(100u, slowInvoked);
+}
+
+TEST_F(SignalTest, DeferredSynchronousConnectDuringDrain) {
+    //connections must make progress while deferred emissions are being drained
+    Signal<int> testSignal;
+    std::atomic<uint32_t> invoked{0};
+    testSignal.connectSlot(ExecutorScheme::DEFERRED_SYNCHRONOUS, [&invoked](int){
+        ++invoked;
+    });
+    for (uint32_t i=0; i<100000; ++i) testSignal.emitSignal(1);
+    
+    std::atomic<bool> connected{false};
+    thread connector([&](){
+        while (invoked == 0) std::this_thread::yield();
+        testSignal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](int){});
+        connected = true;
+    });
+    while (testSignal.invokeDeferred(64) && !connected);
+    connector.join();
+    ASSERT_TRUE(connected);
+    testSignal.invokeDeferred();
+    ASSERT_EQ(100000u, invoked);
+}
+
+TEST_F(SignalTest, DeferredBufferedSignal) {
+    const uint32_t nEmitters = 4;
+    const uint32_t nEmissions = 100000;
+    for (auto threadSafe : {false, true}){
+        Signal<uint32_t, uint32_t> testSignal(threadSafe);
+        vector<uint32_t> lastSeen(nEmitters, 0);
+        uint32_t received = 0;
+        bool ordered = true;
+        testSignal.connectSlot(ExecutorScheme::DEFERRED_BUFFERED, [&](uint32_t emitter, uint32_t seq){
+            ordered &= (seq == lastSeen[emitter] + 1);
+            lastSeen[emitter] = seq;
+            ++received;
+        });
+        
+        list<thread> emitters;
+        for (uint32_t i=0; i<nEmitters; ++i){
+            emitters.emplace_back([&testSignal, i](){
+                for (uint32_t j=1; j<=nEmissions; ++j) testSignal.emitSignal(i, j);
+            });
+        }
+        //drain concurrently with emission, in budgeted slices
+        uint32_t drains = 0;
+        while (received < nEmitters*nEmissions){
+            testSignal.invokeDeferred(1000);
+            ++drains;
+        }
+        for (auto &t : emitters) t.join();
+        ASSERT_EQ(0u, testSignal.invokeDeferred(1000));
+        ASSERT_TRUE(ordered);
+        ASSERT_EQ(nEmitters*nEmissions, received);
+        cout << "Drained in " << drains << " slices" << endl;
+        
+        //remaining count covers both the front and back buffers
+        for (uint32_t j=1; j<=100; ++j) testSignal.emitSignal(0, nEmissions + j);
+        ASSERT_EQ(90u, testSignal.invokeDeferred(10));
+        for (uint32_t j=101; j<=200; ++j) testSignal.emitSignal(0, nEmissions + j);
+        ASSERT_EQ(180u, testSignal.invokeDeferred(10));
+        ASSERT_EQ(0u, testSignal.invokeDeferred(std::chrono::seconds(10)));
+        ASSERT_TRUE(ordered);
+    }
+}
+
+TEST_F(SignalTest, DeferredFrames) {
+    //buffered emissions are invoked completely, and in order, frame by frame
+    const uint32_t nFrames = 10;
+    const uint32_t nEmissionsPerFrame = 10000;
+    for (auto scheme : {ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED}){
+        Signal<uint32_t> testSignal;
+        uint32_t next = 0;
+        bool ordered = true;
+        testSignal.connectSlot(scheme, [&next, &ordered](uint32_t x){
+            ordered &= (x == next);
+            ++next;
+        });
+        for (uint32_t f=0; f<nFrames; ++f){
+            for (uint32_t i=0; i<nEmissionsPerFrame; ++i) testSignal.emitSignal(f*nEmissionsPerFrame + i);
+            testSignal.invokeDeferred();
+            ASSERT_EQ((f + 1)*nEmissionsPerFrame, next);
+        }
+        ASSERT_TRUE(ordered);
+    }
+}
+
+TEST_F(SignalTest, KeyedStrand) {
+    const uint32_t nEmitters = 4;
+    const uint32_t nKeysPerEmitter = 8;
+    const uint32_t nEmissions = 100000;
+    Signal<uint32_t, uint32_t> testSignal;
+    vector<uint32_t> lastSequence(nEmitters*nKeysPerEmitter, 0);
+    atomic<bool> outOfOrder{false};
+    atomic<uint32_t> received{0};
+    std::mutex threadsLock;
+    std::set<std::thread::id> threads;
+    //keys are owned by a single emitter, so each key's sequence must increase
+    testSignal.connectSlot(ExecutorScheme::KEYED_STRAND, [&](uint32_t key, uint32_t sequence){
+        if (sequence <= lastSequence[key]) outOfOrder = true;
+        lastSequence[key] = sequence;
+        if ((sequence & 1023) == 0){
+            std::lock_guard<std::mutex> lock(threadsLock);
+            threads.insert(std::this_thread::get_id());
+        }
+        ++received;
+    });
+    vector<thread> emitters;
+    for (uint32_t e=0; e<nEmitters; ++e){
+        emitters.emplace_back([&, e](){
+            for (uint32_t i=1; i<=nEmissions; ++i){
+                testSignal.emitSignal(e*nKeysPerEmitter + i%nKeysPerEmitter, i);
+            }
+        });
+    }
+    for (auto &t : emitters) t.join();
+    while (received != nEmitters*nEmissions) std::this_thread::yield();
+    ASSERT_FALSE(outOfOrder);
+    cout << "Lanes executed on " << threads.size() << " threads" << endl;
+    ASSERT_GT(threads.size(), 1u);
+}
+
+TEST_F(SignalTest, KeyedStrandKeyFunction) {
+    Signal<std::string, uint32_t> testSignal;
+    vector<vector<uint32_t>> received(4);
+    atomic<uint32_t> count{0};
+    //keyed on the second argument rather than the first
+    testSignal.connectKeyedSlot([](const std::string&, const uint32_t& account){return (size_t)account;},
+        [&](std::string, uint32_t account){
+            received[account].push_back(count++);
+        });
+    for (uint32_t i=0; i<1000; ++i){
+        testSignal.emitSignal("order", i % 4);
+    }
+    while (count != 1000) std::this_thread::yield();
+    for (auto &r : received){
+        ASSERT_EQ(r.size(), 250u);
+    }
+}
+
+TEST_F(SignalTest, ParallelSynchronous) {
+    const uint32_t nSlots = 1000;
+    for (bool threadSafe : {false, true}){
+        Signal<uint32_t> testSignal(threadSafe);
+        vector<uint32_t> received(nSlots, 0);
+        atomic<uint32_t> count{0};
+        vector<int> ids;
+        for (uint32_t i=0; i<nSlots; ++i){
+            ids.push_back(testSignal.connectSlot(ExecutorScheme::PARALLEL_SYNCHRONOUS, [&received, &count, i](uint32_t x){
+                received[i] += x;
+                ++count;
+            }));
+        }
+        for (uint32_t e=1; e<=10; ++e){
+            testSignal.emitSignal(e);
+            //every slot has returned by the time emission does
+            ASSERT_EQ(e*nSlots, count);
+        }
+        for (auto r : received){
+            ASSERT_EQ(55u, r);
+        }
+        //disconnect every second slot
+        for (uint32_t i=0; i<nSlots; i+=2){
+            testSignal.disconnectSlot(ids[i]);
+        }
+        count = 0;
+        testSignal.emitSignal(1);
+        ASSERT_EQ(nSlots/2, count);
+        testSignal.emitSignal(1);
+        ASSERT_EQ(nSlots, count);
+        for (uint32_t i=0; i<nSlots; ++i){
+            ASSERT_EQ(i % 2 ? 57u : 55u, received[i]);
+        }
+    }
+}
+
+TEST_F(SignalTest, ParallelSynchronousBusyPool) {
+    //every pool worker is occupied until the parallel emission has returned,
+    //so it must not wait on helpers which haven't started
+    Signal<uint32_t> blocker;
+    atomic<uint32_t> started{0};
+    atomic<bool> release{false};
+    blocker.connectSlot(ExecutorScheme::THREAD_POOLED, [&started, &release](uint32_t){
+        ++started;
+        while (!release) std::this_thread::yield();
+    });
+    Signal<uint32_t> testSignal(true);
+    atomic<uint32_t> count{0};
+    for (uint32_t i=0; i<1000; ++i){
+        testSignal.connectSlot(ExecutorScheme::PARALLEL_SYNCHRONOUS, [&count](uint32_t){++count;});
+    }
+    for (uint32_t i=0; i<64; ++i) blocker.emitSignal(i);
+    while (started < 32) std::this_thread::yield();
+    testSignal.emitSignal(0);
+    ASSERT_EQ(count, 1000u);
+    release = true;
+    while (started < 64) std::this_thread::yield();
+}
+
+TEST_F(SignalTest, ThreadPoolSlowTaskDoesNotHoldQueuedTasks) {
+    //emissions are posted to the pool's spokes in turn, so every 32nd lands
+    //on the spoke of the slow task. The short tasks queued behind it must be
+    //run by the other workers while it is still running
+    const uint32_t nSpokes = 32;
+    const uint32_t nShort = 8;
+    Signal<uint32_t> testSignal;
+    atomic<bool> slowRunning{false};
+    atomic<uint32_t> shortDone{0};
+    atomic<uint32_t> shortOnSlowThread{0};
+    atomic<std::thread::id> slowThread{std::thread::id()};
+    atomic<bool> slowDone{false};
+    testSignal.connectSlot(ExecutorScheme::THREAD_POOLED, [&](uint32_t x){
+        if (x == 0){
+            slowThread = std::this_thread::get_id();
+            slowRunning = true;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (shortDone < nShort && std::chrono::steady_clock::now() < deadline){
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            slowDone = true;
+        }
+        else if (x % nSpokes == 0){
+            while (!slowRunning) std::this_thread::yield();
+            if (std::this_thread::get_id() == slowThread.load()) ++shortOnSlowThread;
+            ++shortDone;
+        }
+    });
+    //the other emissions are no-ops which wake the idle workers
+    for (uint32_t i=0; i<=nShort*nSpokes + nSpokes - 1; ++i) testSignal.emitSignal(i);
+    while (!slowDone) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(nShort, shortDone.load());
+    ASSERT_EQ(0u, shortOnSlowThread.load());
+}
+
+TEST_F(SignalTest, ParallelSynchronousThrowingSlot) {
+    //slots in several chunks throw, so the exception may be thrown on the
+    //emitting thread or on a helper, and is rethrown by the emitter either way
+    const uint32_t nSlots = 1000;
+    Signal<uint32_t> testSignal;
+    atomic<uint32_t> count{0};
+    for (uint32_t i=0; i<nSlots; ++i){
+        testSignal.connectSlot(ExecutorScheme::PARALLEL_SYNCHRONOUS, [&count, i](uint32_t x){
+            //slow enough that the helpers take chunks of their own
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            if (i % 300 == 299 && x == i) throw std::runtime_error("slot");
+            ++count;
+        });
+    }
+    for (uint32_t e=0; e<10; ++e){
+        for (uint32_t thrower : {299u, 599u, 899u}){
+            ASSERT_THROW(testSignal.emitSignal(thrower), std::runtime_error);
+        }
+    }
+    //the signal is still usable, and every slot runs when none throw
+    count = 0;
+    testSignal.emitSignal(0);
+    ASSERT_EQ(nSlots, count.load());
+}
+
+TEST_F(SignalTest, ParallelSynchronousFanOut) {
+    //every slot runs exactly once per emission, however the slots are split
+    const uint32_t nSlots = 10000;
+    const uint32_t nEmissions = 100;
+    Signal<uint32_t> testSignal;
+    vector<uint32_t> executions(nSlots, 0);
+    for (uint32_t i=0; i<nSlots; ++i){
+        testSignal.connectSlot(ExecutorScheme::PARALLEL_SYNCHRONOUS, [&executions, i](uint32_t){
+            ++executions[i];
+        });
+    }
+    for (uint32_t e=0; e<nEmissions; ++e){
+        testSignal.emitSignal(e);
+    }
+    for (uint32_t i=0; i<nSlots; ++i) ASSERT_EQ(nEmissions, executions[i]);
+}
+
+namespace{
+//runs tasks inline, and records that it was given the task type directly
+struct InlineExecutor{
+    template <typename F>
+    void post(F&& task){
+        static_assert(!std::is_same<typename std::decay<F>::type, std::function<void()>>::value, "task was type erased");
+        ++posted;
+        task();
+    }
+    uint32_t posted{0};
+};
+
+//queues tasks, dispatch should be preferred over post when both exist
+struct QueueingExecutor{
+    void post(std::function<void()> task){
+        ++posted;
+        tasks.push_back(std::move(task));
+    }
+    void dispatch(std::function<void()> task){
+        ++dispatched;
+        tasks.push_back(std::move(task));
+    }
+    void run(){
+        for (auto &t : tasks) t();
+        tasks.clear();
+    }
+    vector<std::function<void()>> tasks;
+    uint32_t posted{0};
+    uint32_t dispatched{0};
+};
+}
+
+TEST_F(SignalTest, CustomExecutor) {
+    InlineExecutor inlineExecutor;
+    QueueingExecutor queueingExecutor;
+    for (auto threadSafe : {false, true}){
+        Signal<int, int> testSignal(threadSafe);
+        int inlineSum = 0;
+        int queuedSum = 0;
+        testSignal.connectSlot(inlineExecutor, [&inlineSum](int x, int y){
+            inlineSum += x + y;
+        });
+        int id = testSignal.connectSlot(queueingExecutor, [&queuedSum](int x, int y){
+            queuedSum += x + y;
+        });
+        testSignal.emitSignal(1, 2);
+        ASSERT_EQ(3, inlineSum);
+        ASSERT_EQ(0, queuedSum);
+        queueingExecutor.run();
+        ASSERT_EQ(3, queuedSum);
+        
+        //tasks still queued when the slot is disconnected are cancelled
+        testSignal.emitSignal(1, 2);
+        testSignal.disconnectSlot(id);
+        queueingExecutor.run();
+        ASSERT_EQ(3, queuedSum);
+        ASSERT_EQ(6, inlineSum);
+    }
+    ASSERT_EQ(4u, inlineExecutor.posted);
+    ASSERT_EQ(4u, queueingExecutor.dispatched);
+    ASSERT_EQ(0u, queueingExecutor.posted);
+}
+
 TEST_F(SignalTest, AsynchronousSignal) {
     cout << "Instantiating signal object" << endl;
 
@@ -186,6 +568,36 @@ TEST_F(SignalTest, StrandSignal) {
 
 }
 
+TEST_F(SignalTest, SingleProducerStrandSignal) {
+    Signal<uint32_t> testSignal;
+    const uint32_t nEmissions = 100000;
+    std::vector<uint32_t> received;
+    received.reserve(nEmissions);
+    testSignal.connectSlot(ExecutorScheme::SINGLE_PRODUCER_STRAND, [&received](uint32_t x){
+        received.push_back(x);
+        globalStaticIntX++;
+    });
+    
+    BasicTimer bt;
+    bt.start();
+    for (uint32_t i=0; i<nEmissions; ++i){
+        testSignal.emitSignal(i);
+    }
+    bt.stop();
+    cout << "Time to emit: " << bt.getElapsedMilliseconds() << "ms" << endl;
+    
+    BasicTimer bt2;
+    bt2.start();
+    while (globalStaticIntX != (int)nEmissions && bt2.getElapsedSeconds() < 5.0){
+        std::this_thread::yield();
+    }
+    ASSERT_EQ((int)nEmissions, globalStaticIntX);
+    for (uint32_t i=0; i<nEmissions; ++i){
+        ASSERT_EQ(i, received[i]);
+    }
+    testSignal.disconnectAllSlots();
+}
+
 TEST_F(SignalTest, MultipleConnectionTypes) {
     cout << "Testing multiple connection types for single signal" << endl;
     Signal<BigThing> testSignal;
@@ -352,3 +764,96 @@ TEST_F(SignalTest, MultiEmit){
     testSignal.disconnectAllSlots();
     for (auto &t : threads) t.join();
 }
+
+struct CopyCounter {
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter&) {++copies;}
+    CopyCounter(CopyCounter&&) noexcept {++moves;}
+    CopyCounter& operator=(const CopyCounter&) {++copies; return *this;}
+    CopyCounter& operator=(CopyCounter&&) noexcept {++moves; return *this;}
+    static atomic<uint32_t> copies;
+    static atomic<uint32_t> moves;
+};
+atomic<uint32_t> CopyCounter::copies{0};
+atomic<uint32_t> CopyCounter::moves{0};
+
+TEST_F(SignalTest, CopyCount){
+    const uint32_t nEmissions = 100;
+    for (auto scheme : {ExecutorScheme::STRAND, ExecutorScheme::THREAD_POOLED, ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED, ExecutorScheme::KEYED_STRAND}){
+        Signal<CopyCounter> testSignal;
+        atomic<uint32_t> received{0};
+        auto slot = [&received](CopyCounter){
+            ++received;
+        };
+        //CopyCounter can't be hashed, so a keyed slot needs a key function
+        if (scheme == ExecutorScheme::KEYED_STRAND){
+            testSignal.connectKeyedSlot([](const CopyCounter&){return (size_t)0;}, slot);
+        }
+        else{
+            testSignal.connectSlot(scheme, slot);
+        }
+        CopyCounter::copies = 0;
+        CopyCounter::moves = 0;
+        CopyCounter cc;
+        for (uint32_t i=0; i<nEmissions; ++i){
+            testSignal.emitSignal(cc);
+        }
+        testSignal.invokeDeferred();
+        BasicTimer bt;
+        bt.start();
+        while (received != nEmissions && bt.getElapsedSeconds() < 1.0){
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(nEmissions, received);
+        cout << "Copies: " << CopyCounter::copies << ", Moves: " << CopyCounter::moves << endl;
+        //the only copy is taken when the emitted arguments are queued
+        ASSERT_EQ(nEmissions, CopyCounter::copies);
+    }
+}
+
+struct NoDefault{
+    explicit NoDefault(uint32_t v) : value(v){}
+    uint32_t value;
+};
+
+TEST_F(SignalTest, NonDefaultConstructibleArguments){
+    const uint32_t nEmissions = 100;
+    for (auto scheme : {ExecutorScheme::SYNCHRONOUS, ExecutorScheme::DEFERRED_SYNCHRONOUS, ExecutorScheme::DEFERRED_BUFFERED,
+            ExecutorScheme::ASYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::SINGLE_PRODUCER_STRAND,
+            ExecutorScheme::THREAD_POOLED, ExecutorScheme::KEYED_STRAND, ExecutorScheme::PARALLEL_SYNCHRONOUS}){
+        Signal<NoDefault> testSignal;
+        atomic<uint32_t> sum{0};
+        auto slot = [&sum](NoDefault x){
+            sum += x.value;
+        };
+        //NoDefault can't be hashed, so a keyed slot needs a key function
+        if (scheme == ExecutorScheme::KEYED_STRAND){
+            testSignal.connectKeyedSlot([](const NoDefault& x){return (size_t)x.value;}, slot);
+        }
+        else{
+            testSignal.connectSlot(scheme, slot);
+        }
+        for (uint32_t i=1; i<=nEmissions; ++i){
+            testSignal.emitSignal(NoDefault(i));
+        }
+        testSignal.invokeDeferred();
+        BasicTimer bt;
+        bt.start();
+        while (sum != nEmissions*(nEmissions+1)/2 && bt.getElapsedSeconds() < 1.0){
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(nEmissions*(nEmissions+1)/2, sum);
+    }
+}
+
+TEST_F(SignalTest, KeyedStrandNeedsKey){
+    //without a hashable first argument, keyed slots must be given a key function
+    Signal<NoDefault> testSignal;
+    ASSERT_THROW(testSignal.connectSlot(ExecutorScheme::KEYED_STRAND, [](NoDefault){}), std::invalid_argument);
+    ASSERT_THROW(testSignal.connectKeyedSlot(nullptr, [](NoDefault){}), std::invalid_argument);
+    Signal<> emptySignal;
+    ASSERT_THROW(emptySignal.connectSlot(ExecutorScheme::KEYED_STRAND, [](){}), std::invalid_argument);
+    //the other schemes are unaffected
+    testSignal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](NoDefault){});
+    testSignal.emitSignal(NoDefault(1));
+}
@@ -28,6 +28,7 @@ void SignalTestParametrized::SetUp() {
     cout << "Test for signal type: ";
     switch (params.scheme) {
         case (ExecutorScheme::DEFERRED_SYNCHRONOUS):
+        case (ExecutorScheme::DEFERRED_BUFFERED):
             return;
         case(ExecutorScheme::ASYNCHRONOUS):
             cout << "Asynchronous";
@@ -35,12 +36,21 @@ void SignalTestParametrized::SetUp() {
         case(ExecutorScheme::STRAND):
             cout << "Strand";
             break;
+        case(ExecutorScheme::SINGLE_PRODUCER_STRAND):
+            cout << "Single Producer Strand";
+            break;
         case(ExecutorScheme::SYNCHRONOUS):
             cout << "Synchronous";
             break;
         case (ExecutorScheme::THREAD_POOLED):
             cout << "Thread Pooled";
             break;
+        case (ExecutorScheme::KEYED_STRAND):
+            cout << "Keyed Strand";
+            break;
+        case (ExecutorScheme::PARALLEL_SYNCHRONOUS):
+            cout << "Parallel Synchronous";
+            break;
     }
     cout << endl;
         
@@ -64,7 +74,7 @@ TEST_P(SignalTestParametrized, IntenseUsage) {
     auto func = ([this](sigType x) {
         volatile sigType v = x;
         for (uint32_t i = 0; i < params.nOperations; i++) {
-            v+=x;
+            v = v + x;
         }
         completedFunctions++;
     });
@@ -124,7 +134,7 @@ TEST_P(SignalTestParametrized, Correctness) {
     auto func = ([this, &doneFlags](sigType x) {
         volatile sigType v = x;
         for (uint32_t i = 0; i < params.nOperations; i++) {
-            v+=x;
+            v = v + x;
         }
         doneFlags[x] = 1;
         completedFunctions++;
@@ -275,7 +285,7 @@ INSTANTIATE_TEST_CASE_P(
         Values(1), //number of operations
         Values(1, 2, 4, 8, 16, 32, 64), //number of emitters
         Values(true, false),
-        Values(ExecutorScheme::SYNCHRONOUS, ExecutorScheme::ASYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::THREAD_POOLED)
+        Values(ExecutorScheme::SYNCHRONOUS, ExecutorScheme::ASYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::THREAD_POOLED, ExecutorScheme::KEYED_STRAND)
         )
         );
 
@@ -290,4 +300,19 @@ INSTANTIATE_TEST_CASE_P(
         Values(true, false),
         Values(ExecutorScheme::SYNCHRONOUS, ExecutorScheme::STRAND, ExecutorScheme::THREAD_POOLED) //asynchronous is too slow for this
         )
+        );
+
+//timing of the single producer strand is in the benchmark binary
+//(single_producer/...), this only checks every emission is delivered
+INSTANTIATE_TEST_CASE_P(
+        SignalTest_SingleProducer,
+        SignalTestParametrized,
+        testing::Combine(
+        Values(1, 10), //nconnections
+        Values(10000), //number of emissions
+        Values(1), //number of operations
+        Values(1), //number of emitters (single producer strand requires exactly 1)
+        Values(false),
+        Values(ExecutorScheme::SINGLE_PRODUCER_STRAND)
+        )
         );
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "TracingTest.h"
+#include <sstream>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdio>
+
+#include "BSignals/Signal.hpp"
+#include "BSignals/Instrumentation.h"
+#include "BSignals/Tracing.h"
+
+using BSignals::Signal;
+using BSignals::BasicSignal;
+using BSignals::ExecutorScheme;
+using BSignals::TracingInstrumentation;
+using BSignals::details::Tracer;
+using BSignals::details::TraceEvent;
+using BSignals::details::TraceEventType;
+using BSignals::details::ThreadTrace;
+using std::atomic;
+using std::vector;
+
+namespace{
+
+uint64_t countEvents(const vector<ThreadTrace>& traces){
+    uint64_t n = 0;
+    for (auto const &trace : traces) n += trace.events.size();
+    return n;
+}
+
+}
+
+void TracingTest::SetUp() {
+
+}
+
+void TracingTest::TearDown() {
+
+}
+
+TEST_F(TracingTest, Handoff){
+    const uint32_t nEmissions = 100;
+    BasicSignal<TracingInstrumentation, uint32_t> signal(true);
+    atomic<uint32_t> count{0};
+    int synchronousId = signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [&count](uint32_t){++count;});
+    signal.connectSlot(ExecutorScheme::STRAND, [&count](uint32_t){++count;});
+    signal.connectSlot(ExecutorScheme::KEYED_STRAND, [&count](uint32_t){++count;});
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [&count](uint32_t){++count;});
+    BSignals::startTracing();
+    for (uint32_t i=0; i<nEmissions; ++i){
+        signal.emitAsync(i).wait();
+    }
+    BSignals::stopTracing();
+    ASSERT_EQ(4*nEmissions, count);
+
+    //events of each (emission, slot), in the order they were recorded by each thread
+    std::map<uint64_t, uint32_t> emits;
+    std::map<std::pair<uint64_t, uint32_t>, vector<TraceEventType>> handoffs;
+    std::map<std::pair<uint64_t, uint32_t>, uint64_t> enqueueTime, executeTime;
+    for (auto const &trace : Tracer::collect()){
+        for (auto const &e : trace.events){
+            auto key = std::make_pair(e.emissionId, e.slotId);
+            switch(e.type){
+                case(TraceEventType::EMIT_BEGIN):
+                    ++emits[e.emissionId];
+                    break;
+                case(TraceEventType::ENQUEUE):
+                    enqueueTime[key] = e.timestamp;
+                    handoffs[key].push_back(e.type);
+                    break;
+                case(TraceEventType::EXECUTE_BEGIN):
+                    executeTime[key] = e.timestamp;
+                    handoffs[key].push_back(e.type);
+                    break;
+                case(TraceEventType::DEQUEUE):
+                case(TraceEventType::STEAL):
+                    handoffs[key].push_back(TraceEventType::DEQUEUE);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    ASSERT_EQ(nEmissions, emits.size());
+    //3 queued slots per emission, each enqueued, dequeued and executed
+    ASSERT_EQ(3*nEmissions, handoffs.size());
+    for (auto const &kvpair : handoffs){
+        ASSERT_NE((uint32_t)synchronousId, kvpair.first.second);
+        ASSERT_EQ(1u, emits.count(kvpair.first.first));
+        ASSERT_EQ(3u, kvpair.second.size());
+        ASSERT_LE(enqueueTime[kvpair.first], executeTime[kvpair.first]);
+    }
+}
+
+TEST_F(TracingTest, OnlyWhileTracing){
+    BasicSignal<TracingInstrumentation, uint32_t> traced;
+    Signal<uint32_t> untraced;
+    traced.connectSlot(ExecutorScheme::STRAND, [](uint32_t){});
+    untraced.connectSlot(ExecutorScheme::STRAND, [](uint32_t){});
+    BSignals::startTracing();
+    ASSERT_TRUE(BSignals::isTracing());
+    untraced.emitAsync(0).wait();
+    ASSERT_EQ(0u, countEvents(Tracer::collect()));
+    traced.emitAsync(0).wait();
+    uint64_t n = countEvents(Tracer::collect());
+    //emit and dispatch begin and end, enqueue, dequeue and execute begin and end
+    ASSERT_EQ(8u, n);
+    BSignals::stopTracing();
+    ASSERT_FALSE(BSignals::isTracing());
+    traced.emitAsync(0).wait();
+    ASSERT_EQ(n, countEvents(Tracer::collect()));
+    //a new trace discards the events of the last
+    BSignals::startTracing();
+    ASSERT_EQ(0u, countEvents(Tracer::collect()));
+    BSignals::stopTracing();
+}
+
+TEST_F(TracingTest, RingOverwritesOldest){
+    BasicSignal<TracingInstrumentation, uint32_t> signal;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){});
+    BSignals::startTracing(10);
+    for (uint32_t i=0; i<100; ++i){
+        signal.emitSignal(i);
+    }
+    BSignals::stopTracing();
+    auto traces = Tracer::collect();
+    ASSERT_EQ(1u, traces.size());
+    //capacity is rounded up to 16, of which the newest 15 events are kept
+    //(the oldest cell may be being overwritten), and each emission records 4
+    auto const &events = traces.front().events;
+    ASSERT_EQ(15u, events.size());
+    ASSERT_EQ(TraceEventType::EMIT_BEGIN, events[3].type);
+    ASSERT_EQ(TraceEventType::EMIT_END, events.back().type);
+    for (size_t i=1; i<events.size(); ++i){
+        ASSERT_LE(events[i-1].timestamp, events[i].timestamp);
+    }
+    std::set<uint64_t> emissions;
+    for (auto const &e : events) emissions.insert(e.emissionId);
+    ASSERT_EQ(4u, emissions.size());
+}
+
+TEST_F(TracingTest, CollectWhileRecording){
+    BasicSignal<TracingInstrumentation, uint32_t> signal;
+    signal.connectSlot(ExecutorScheme::SYNCHRONOUS, [](uint32_t){});
+    BSignals::startTracing(64);
+    atomic<bool> stop{false};
+    std::thread emitter([&](){
+        for (uint32_t i=0; !stop; ++i) signal.emitSignal(i);
+    });
+    for (uint32_t c=0; c<1000; ++c){
+        //events overwritten during a copy are dropped rather than torn
+        for (auto const &trace : Tracer::collect()){
+            ASSERT_LE(trace.events.size(), 63u);
+            for (size_t i=1; i<trace.events.size(); ++i){
+                ASSERT_LE(trace.events[i-1].timestamp, trace.events[i].timestamp);
+                ASSERT_LE(trace.events[i-1].emissionId, trace.events[i].emissionId);
+            }
+        }
+    }
+    stop = true;
+    emitter.join();
+    BSignals::stopTracing();
+}
+
+TEST_F(TracingTest, ChromeTraceExport){
+    BasicSignal<TracingInstrumentation, uint32_t> signal;
+    signal.connectSlot(ExecutorScheme::THREAD_POOLED, [](uint32_t){});
+    BSignals::startTracing();
+    signal.emitAsync(0).wait();
+    BSignals::stopTracing();
+    std::stringstream ss;
+    BSignals::exportChromeTrace(ss);
+    std::string json = ss.str();
+    ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+    for (auto name : {"\"emit\"", "\"dispatch\"", "\"enqueue\"", "\"execute\"", "\"thread_name\""}){
+        ASSERT_NE(std::string::npos, json.find(name)) << name;
+    }
+    //the handoff flow starts at the enqueue and ends at the execution
+    ASSERT_NE(std::string::npos, json.find("\"ph\":\"s\""));
+    ASSERT_NE(std::string::npos, json.find("\"ph\":\"f\",\"bp\":\"e\""));
+    int depth = 0;
+    for (char c : json){
+        if (c == '{' || c == '[') ++depth;
+        else if (c == '}' || c == ']') --depth;
+        ASSERT_GE(depth, 0);
+    }
+    ASSERT_EQ(0, depth);
+
+    std::string path = "/tmp/bsignals_trace_test.json";
+    ASSERT_TRUE(BSignals::exportChromeTrace(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    ASSERT_EQ(json, contents.str());
+    std::remove(path.c_str());
+    ASSERT_FALSE(BSignals::exportChromeTrace(std::string("/nonexistent/trace.json")));
+}
@@ -0,0 +1,20 @@
+/* 
+ * File:   TracingTest.h
+ * Author: Barath Kannan
+ *
+ * Created on 20 October 2026, 6:20 AM
+ */
+
+#ifndef BSIGNALS_TRACINGTEST_H
+#define BSIGNALS_TRACINGTEST_H
+
+#include <gtest/gtest.h>
+
+class TracingTest : public testing::Test{
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+    
+};
+
+#endif /* BSIGNALS_TRACINGTEST_H */